@@ -22,11 +22,66 @@ uint64_t averageDmg(const DamageRange & range)
 	return (range.min + range.max) / 2;
 }
 
+std::optional<size_t> DamageCache::findSlot(uint32_t unitId) const
+{
+	if(unitId >= slotByUnitId.size() || slotByUnitId[unitId] == NO_SLOT)
+		return std::nullopt;
+
+	return slotByUnitId[unitId];
+}
+
+size_t DamageCache::getOrCreateSlot(uint32_t unitId)
+{
+	auto slot = findSlot(unitId);
+
+	if(slot)
+		return *slot;
+
+	if(unitIds.size() == stride)
+	{
+		// battle normally has few dozens of units, so matrix is rarely regrown
+		size_t newStride = std::max<size_t>(32, stride * 2);
+		std::vector<float> newCache(newStride * newStride, DAMAGE_NOT_CACHED);
+
+		for(size_t row = 0; row < unitIds.size(); row++)
+			std::copy_n(damageCache.begin() + row * stride, unitIds.size(), newCache.begin() + row * newStride);
+
+		damageCache = std::move(newCache);
+		stride = newStride;
+	}
+
+	if(unitId >= slotByUnitId.size())
+		slotByUnitId.resize(unitId + 1, NO_SLOT);
+
+	slotByUnitId[unitId] = unitIds.size();
+	unitIds.push_back(unitId);
+	return unitIds.size() - 1;
+}
+
+float & DamageCache::cachedDamage(const battle::Unit * attacker, const battle::Unit * defender)
+{
+	auto attackerSlot = getOrCreateSlot(attacker->unitId());
+	auto defenderSlot = getOrCreateSlot(defender->unitId());
+
+	return damageCache[attackerSlot * stride + defenderSlot];
+}
+
+float DamageCache::findCachedDamage(const battle::Unit * attacker, const battle::Unit * defender) const
+{
+	auto attackerSlot = findSlot(attacker->unitId());
+	auto defenderSlot = findSlot(defender->unitId());
+
+	if(!attackerSlot || !defenderSlot)
+		return DAMAGE_NOT_CACHED;
+
+	return damageCache[*attackerSlot * stride + *defenderSlot];
+}
+
 void DamageCache::cacheDamage(const battle::Unit * attacker, const battle::Unit * defender, std::shared_ptr<CBattleInfoCallback> hb)
 {
 	auto damage = averageDmg(hb->battleEstimateDamage(attacker, defender, 0).damage);
 
-	damageCache[attacker->unitId()][defender->unitId()] = static_cast<float>(damage) / attacker->getCount();
+	cachedDamage(attacker, defender) = static_cast<float>(damage) / attacker->getCount();
 }
 
 void DamageCache::buildObstacleDamageCache(std::shared_ptr<HypotheticBattle> hb, BattleSide side)
@@ -101,6 +156,8 @@ void DamageCache::buildDamageCache(std::shared_ptr<HypotheticBattle> hb, BattleS
 			ourUnits.push_back(stack);
 		else
 			enemyUnits.push_back(stack);
+
+		getOrCreateSlot(stack->unitId());
 	}
 
 	for(auto ourUnit : ourUnits)
@@ -119,18 +176,55 @@ void DamageCache::buildDamageCache(std::shared_ptr<HypotheticBattle> hb, BattleS
 	}
 }
 
+DamageCache DamageCache::layerOver(const DamageCache & base)
+{
+	DamageCache layer(base.parent);
+
+	layer.base = &base;
+
+	return layer;
+}
+
+void DamageCache::merge(const DamageCache & layer)
+{
+	std::vector<size_t> ourSlots;
+	for(auto unitId : layer.unitIds)
+		ourSlots.push_back(getOrCreateSlot(unitId));
+
+	for(size_t attackerSlot = 0; attackerSlot < layer.unitIds.size(); attackerSlot++)
+	{
+		for(size_t defenderSlot = 0; defenderSlot < layer.unitIds.size(); defenderSlot++)
+		{
+			float damage = layer.damageCache[attackerSlot * layer.stride + defenderSlot];
+
+			if(damage == DAMAGE_NOT_CACHED)
+				continue;
+
+			damageCache[ourSlots[attackerSlot] * stride + ourSlots[defenderSlot]] = damage;
+		}
+	}
+}
+
 int64_t DamageCache::getDamage(const battle::Unit * attacker, const battle::Unit * defender, std::shared_ptr<CBattleInfoCallback> hb)
 {
-	bool wasComputedBefore = damageCache[attacker->unitId()].count(defender->unitId());
+	float & damage = cachedDamage(attacker, defender);
+
+	if(damage == DAMAGE_NOT_CACHED && base)
+		damage = base->findCachedDamage(attacker, defender);
+
+	bool wasComputedBefore = damage != DAMAGE_NOT_CACHED;
 
 	if (!wasComputedBefore)
-		cacheDamage(attacker, defender, hb);
+		cacheDamage(attacker, defender, hb); // both units have slots already, reference stays valid
 
-	return damageCache[attacker->unitId()][defender->unitId()] * attacker->getCount();
+	return damage * attacker->getCount();
 }
 
-int64_t DamageCache::getObstacleDamage(BattleHex hex, const battle::Unit * defender)
+int64_t DamageCache::getObstacleDamage(BattleHex hex, const battle::Unit * defender) const
 {
+	if(base)
+		return base->getObstacleDamage(hex, defender);
+
 	if(parent)
 		return parent->getObstacleDamage(hex, defender);
 
@@ -150,16 +244,11 @@ int64_t DamageCache::getOriginalDamage(const battle::Unit * attacker, const batt
 {
 	if(parent)
 	{
-		auto attackerDamageMap = parent->damageCache.find(attacker->unitId());
+		auto originalDamage = parent->findCachedDamage(attacker, defender);
 
-		if(attackerDamageMap != parent->damageCache.end())
+		if(originalDamage != DAMAGE_NOT_CACHED)
 		{
-			auto targetDamage = attackerDamageMap->second.find(defender->unitId());
-
-			if(targetDamage != attackerDamageMap->second.end())
-			{
-				return static_cast<int64_t>(targetDamage->second * attacker->getCount());
-			}
+			return static_cast<int64_t>(originalDamage * attacker->getCount());
 		}
 	}
 
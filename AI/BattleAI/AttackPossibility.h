@@ -14,22 +14,42 @@
 
 #define BATTLE_TRACE_LEVEL 0
 
+/// Damage of one creature of attacker against defender for every pair of units in battle.
+/// Units are assigned to slots of dense matrix, child cache only reads its parent and never modifies it
 class DamageCache
 {
 private:
-	std::unordered_map<uint32_t, std::unordered_map<uint32_t, float>> damageCache;
+	static constexpr float DAMAGE_NOT_CACHED = -1;
+	static constexpr uint32_t NO_SLOT = std::numeric_limits<uint32_t>::max();
+
+	std::vector<uint32_t> unitIds; // id of unit assigned to each slot
+	std::vector<uint32_t> slotByUnitId; // [unit id], unit ids are small sequential numbers assigned by battle
+	std::vector<float> damageCache; // [attacker slot * stride + defender slot]
+	size_t stride;
 	std::map<BattleHex, std::unordered_map<uint32_t, int64_t>> obstacleDamage;
-	DamageCache * parent;
+	const DamageCache * parent;
+	const DamageCache * base; // cache of the same battle state which is read but never written by this layer
 
 	void buildObstacleDamageCache(std::shared_ptr<HypotheticBattle> hb, BattleSide side);
 
+	std::optional<size_t> findSlot(uint32_t unitId) const;
+	size_t getOrCreateSlot(uint32_t unitId);
+	float & cachedDamage(const battle::Unit * attacker, const battle::Unit * defender);
+	float findCachedDamage(const battle::Unit * attacker, const battle::Unit * defender) const;
+
 public:
-	DamageCache() : parent(nullptr) {}
-	DamageCache(DamageCache * parent) : parent(parent) {}
+	DamageCache() : stride(0), parent(nullptr), base(nullptr) {}
+	DamageCache(const DamageCache * parent) : stride(0), parent(parent), base(nullptr) {}
+
+	/// Creates a layer over cache of the same battle state. Already cached damage is read from the base cache,
+	/// newly computed one is stored in the layer only, so several layers can be used from parallel tasks
+	static DamageCache layerOver(const DamageCache & base);
+	/// Copies damage computed by the layer back, so it can be reused by later evaluations
+	void merge(const DamageCache & layer);
 
 	void cacheDamage(const battle::Unit * attacker, const battle::Unit * defender, std::shared_ptr<CBattleInfoCallback> hb);
 	int64_t getDamage(const battle::Unit * attacker, const battle::Unit * defender, std::shared_ptr<CBattleInfoCallback> hb);
-	int64_t getObstacleDamage(BattleHex hex, const battle::Unit * defender);
+	int64_t getObstacleDamage(BattleHex hex, const battle::Unit * defender) const;
 	int64_t getOriginalDamage(const battle::Unit * attacker, const battle::Unit * defender, std::shared_ptr<CBattleInfoCallback> hb);
 	void buildDamageCache(std::shared_ptr<HypotheticBattle> hb, BattleSide side);
 };
@@ -683,8 +683,7 @@ bool BattleEvaluator::attemptCastingSpell(const CStack * activeStack)
 						return  !original || u->getMovementRange() != original->getMovementRange();
 					});
 
-				DamageCache safeCopy = damageCache;
-				DamageCache innerCache(&safeCopy);
+				DamageCache innerCache(&damageCache);
 
 				innerCache.buildDamageCache(state, side);
 
@@ -9,6 +9,7 @@
  */
 #include "StdInc.h"
 #include "BattleExchangeVariant.h"
+#include "tbb/parallel_for.h"
 #include "../../lib/CStack.h"
 
 AttackerValue::AttackerValue()
@@ -229,9 +230,12 @@ EvaluationResult BattleExchangeEvaluator::findBestTarget(
 
 		updateReachabilityMap(hbWaited);
 
-		for(auto & ap : targets.possibleAttacks)
+		auto scores = evaluateExchanges(targets, damageCache, hbWaited);
+
+		for(size_t i = 0; i < targets.possibleAttacks.size(); i++)
 		{
-			float score = evaluateExchange(ap, 0, targets, damageCache, hbWaited);
+			auto & ap = targets.possibleAttacks[i];
+			float score = scores[i];
 
 			if(score > result.score)
 			{
@@ -261,9 +265,12 @@ EvaluationResult BattleExchangeEvaluator::findBestTarget(
 			return result; // lets wait
 	}
 
-	for(auto & ap : targets.possibleAttacks)
+	auto scores = evaluateExchanges(targets, damageCache, hb);
+
+	for(size_t i = 0; i < targets.possibleAttacks.size(); i++)
 	{
-		float score = evaluateExchange(ap, 0, targets, damageCache, hb);
+		auto & ap = targets.possibleAttacks[i];
+		float score = scores[i];
 		bool sameScoreButWaited = vstd::isAlmostEqual(score, result.score) && result.wait;
 
 		if(score > result.score || sameScoreButWaited)
@@ -599,6 +606,41 @@ float BattleExchangeEvaluator::evaluateExchange(
 	return scoreValue(score);
 }
 
+std::vector<float> BattleExchangeEvaluator::evaluateExchanges(
+	PotentialTargets & targets,
+	DamageCache & damageCache,
+	std::shared_ptr<HypotheticBattle> hb) const
+{
+	auto & attacks = targets.possibleAttacks;
+	std::vector<float> scores(attacks.size());
+	std::vector<DamageCache> layers;
+
+	layers.reserve(attacks.size());
+
+	for(size_t i = 0; i < attacks.size(); i++)
+		layers.push_back(DamageCache::layerOver(damageCache));
+
+#if BATTLE_TRACE_LEVEL >= 1
+	tbb::blocked_range<size_t> r(0, attacks.size());
+#else
+	tbb::parallel_for(tbb::blocked_range<size_t>(0, attacks.size()), [&](const tbb::blocked_range<size_t> & r)
+		{
+#endif
+			for(auto i = r.begin(); i != r.end(); i++)
+			{
+				scores[i] = evaluateExchange(attacks[i], 0, targets, layers[i], hb);
+			}
+#if BATTLE_TRACE_LEVEL == 0
+		});
+#endif
+
+	// merged in fixed order once all tasks are done, shared cache is not modified while tasks are running
+	for(auto & layer : layers)
+		damageCache.merge(layer);
+
+	return scores;
+}
+
 BattleScore BattleExchangeEvaluator::calculateExchange(
 	const AttackPossibility & ap,
 	uint8_t turn,
@@ -968,6 +1010,8 @@ bool BattleExchangeEvaluator::checkPositionBlocksOurStacks(HypotheticBattle & hb
 	float blockingScore = 0;
 
 	auto activeUnitDamage = activeUnit->getMinDamage(hb.battleCanShoot(activeUnit)) * activeUnit->getCount();
+	auto vacatedHexes = cb->battleGetUnitByID(activeUnit->unitId())->getHexes();
+	auto occupiedHexes = battle::Unit::getHexes(position, activeUnit->doubleWide(), activeUnit->unitSide());
 
 	for(int turn = 0; turn < turnOrder.size(); turn++)
 	{
@@ -985,7 +1029,12 @@ bool BattleExchangeEvaluator::checkPositionBlocksOurStacks(HypotheticBattle & hb
 			auto blockedUnitDamage = unit->getMinDamage(hb.battleCanShoot(unit)) * unit->getCount();
 			float ratio = blockedUnitDamage / (float)(blockedUnitDamage + activeUnitDamage + 0.01);
 
-			auto unitReachability = turnBattle.getReachability(unit);
+			auto reachabilityIter = unmovedReachabilityCache.find(unit->unitId());
+
+			if(reachabilityIter == unmovedReachabilityCache.end())
+				reachabilityIter = unmovedReachabilityCache.emplace(unit->unitId(), cb->getReachability(unit)).first;
+
+			auto unitReachability = turnBattle.updateReachability(reachabilityIter->second, vacatedHexes, occupiedHexes);
 			auto unitSpeed = unit->getMovementRange(turn); // Cached value, to avoid performance hit
 
 			for(BattleHex hex = BattleHex::TOP_LEFT; hex.isValid(); hex = hex + 1)
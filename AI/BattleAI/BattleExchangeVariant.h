@@ -129,6 +129,7 @@ private:
 	std::shared_ptr<CBattleInfoCallback> cb;
 	std::shared_ptr<Environment> env;
 	std::map<uint32_t, ReachabilityInfo> reachabilityCache;
+	std::map<uint32_t, ReachabilityInfo> unmovedReachabilityCache; // reachability in original battle state, updated when checking positions of active unit
 	std::map<BattleHex, std::vector<const battle::Unit *>> reachabilityMap;
 	std::vector<battle::Units> turnOrder;
 	float negativeEffectMultiplier;
@@ -144,6 +145,12 @@ private:
 		std::shared_ptr<HypotheticBattle> hb,
 		std::vector<const battle::Unit *> additionalUnits = {}) const;
 
+	/// Evaluates exchanges of all possible attacks in parallel. Scores are returned in order of targets.possibleAttacks
+	std::vector<float> evaluateExchanges(
+		PotentialTargets & targets,
+		DamageCache & damageCache,
+		std::shared_ptr<HypotheticBattle> hb) const;
+
 	bool canBeHitThisTurn(const AttackPossibility & ap);
 
 public:
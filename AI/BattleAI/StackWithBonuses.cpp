@@ -172,7 +172,11 @@ TConstBonusListPtr StackWithBonuses::getAllBonuses(const CSelector & selector, c
 
 int64_t StackWithBonuses::getTreeVersion() const
 {
-	auto result = owner->getTreeVersion();
+	// real nodes take their versions from one global counter, so a change of either node gives a larger maximum
+	auto result = std::max(owner->getBonusBearer()->getTreeVersion(), origBearer->getTreeVersion());
+
+	// hypothetic changes are counted separately and only ever grow
+	result += owner->getHypotheticTreeVersion();
 
 	if(bonusesToAdd.empty() && bonusesToUpdate.empty() && bonusesToRemove.empty())
 		return result;
@@ -487,7 +491,12 @@ BattleLayout HypotheticBattle::getLayout() const
 
 int64_t HypotheticBattle::getTreeVersion() const
 {
-	return getBonusBearer()->getTreeVersion() + bonusTreeVersion;
+	return getBonusBearer()->getTreeVersion() + getHypotheticTreeVersion();
+}
+
+int64_t HypotheticBattle::getHypotheticTreeVersion() const
+{
+	return bonusTreeVersion;
 }
 
 #if SCRIPTING_ENABLED
@@ -163,6 +163,8 @@ public:
 	BattleLayout getLayout() const override;
 
 	int64_t getTreeVersion() const;
+	/// number of bonus changes applied to this battle on top of real one
+	int64_t getHypotheticTreeVersion() const;
 
 	void makeWait(const battle::Unit * activeStack);
 
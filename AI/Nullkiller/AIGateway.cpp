@@ -30,6 +30,7 @@
 
 #include "AIGateway.h"
 #include "Goals/Goals.h"
+#include "Analyzers/SharedThreatMap.h"
 
 namespace NKAI
 {
@@ -75,6 +76,7 @@ AIGateway::AIGateway()
 	makingTurn = nullptr;
 	destinationTeleport = ObjectInstanceID();
 	destinationTeleportPos = int3(-1);
+	threatMapGameState = 0;
 	nullkiller.reset(new Nullkiller());
 }
 
@@ -83,6 +85,9 @@ AIGateway::~AIGateway()
 	LOG_TRACE(logAi);
 	finish();
 	nullkiller.reset();
+
+	if(threatMapGameState)
+		SharedThreatMap::removeUser(threatMapGameState);
 }
 
 void AIGateway::availableCreaturesChanged(const CGDwelling * town)
@@ -107,6 +112,8 @@ void AIGateway::heroMoved(const TryMoveHero & details, bool verbose)
 	const CGObjectInstance * o1 = vstd::frontOrNull(cb->getVisitableObjs(from, verbose));
 	const CGObjectInstance * o2 = vstd::frontOrNull(cb->getVisitableObjs(to, verbose));
 
+	nullkiller->pathfinder->invalidateTiles({from, to});
+
 	if(details.result == TryMoveHero::TELEPORTATION)
 	{
 		auto t1 = dynamic_cast<const CGTeleport *>(o1);
@@ -126,12 +133,15 @@ void AIGateway::heroMoved(const TryMoveHero & details, bool verbose)
 	{
 		//make sure AI not attempt to visit used boat
 		validateObject(hero->boat);
+		// boats can be used by any hero, e.g. with summon boat spell
+		nullkiller->pathfinder->invalidateAll();
 	}
 	else if(details.result == TryMoveHero::DISEMBARK && o1)
 	{
 		auto boat = dynamic_cast<const CGBoat *>(o1);
 		if(boat)
 			addVisitableObj(boat);
+		nullkiller->pathfinder->invalidateAll();
 	}
 }
 
@@ -139,6 +149,8 @@ void AIGateway::heroInGarrisonChange(const CGTownInstance * town)
 {
 	LOG_TRACE(logAi);
 	NET_EVENT_HANDLER;
+
+	nullkiller->pathfinder->invalidateObject(town);
 }
 
 void AIGateway::centerView(int3 pos, int focusTime)
@@ -252,6 +264,10 @@ void AIGateway::heroVisit(const CGHeroInstance * visitor, const CGObjectInstance
 	{
 		nullkiller->memory->markObjectVisited(visitedObj);
 		nullkiller->objectClusterizer->invalidate(visitedObj->id);
+
+		// keymaster opens border gates and guards anywhere on the map
+		if(visitedObj->ID == Obj::KEYMASTER)
+			nullkiller->pathfinder->invalidateAll();
 	}
 
 	status.heroVisit(visitedObj, start);
@@ -275,6 +291,7 @@ void AIGateway::tileHidden(const std::unordered_set<int3> & pos)
 	NET_EVENT_HANDLER;
 
 	nullkiller->memory->removeInvisibleObjects(myCb.get());
+	nullkiller->pathfinder->invalidateTiles(std::vector<int3>(pos.begin(), pos.end()));
 }
 
 void AIGateway::tileRevealed(const std::unordered_set<int3> & pos)
@@ -286,6 +303,8 @@ void AIGateway::tileRevealed(const std::unordered_set<int3> & pos)
 		for(const CGObjectInstance * obj : myCb->getVisitableObjs(tile))
 			addVisitableObj(obj);
 	}
+
+	nullkiller->pathfinder->invalidateTiles(std::vector<int3>(pos.begin(), pos.end()));
 }
 
 void AIGateway::heroExchangeStarted(ObjectInstanceID hero1, ObjectInstanceID hero2, QueryID query)
@@ -353,6 +372,15 @@ void AIGateway::garrisonsChanged(ObjectInstanceID id1, ObjectInstanceID id2)
 {
 	LOG_TRACE(logAi);
 	NET_EVENT_HANDLER;
+
+	// danger of guards depends on their armies
+	for(auto id : {id1, id2})
+	{
+		auto obj = myCb->getObj(id, false);
+
+		if(obj)
+			nullkiller->pathfinder->invalidateObject(obj);
+	}
 }
 
 void AIGateway::newObject(const CGObjectInstance * obj)
@@ -361,6 +389,11 @@ void AIGateway::newObject(const CGObjectInstance * obj)
 	NET_EVENT_HANDLER;
 	if(obj->isVisitable())
 		addVisitableObj(obj);
+
+	if(obj->ID == Obj::BOAT)
+		nullkiller->pathfinder->invalidateAll();
+	else
+		nullkiller->pathfinder->invalidateObject(obj);
 }
 
 //to prevent AI from accessing objects that got deleted while they became invisible (Cover of Darkness, enemy hero moved etc.) below code allows AI to know deletion of objects out of sight
@@ -376,6 +409,11 @@ void AIGateway::objectRemoved(const CGObjectInstance * obj, const PlayerColor &
 	nullkiller->memory->removeFromMemory(obj);
 	nullkiller->objectClusterizer->onObjectRemoved(obj->id);
 
+	if(obj->ID == Obj::BOAT || dynamic_cast<const CGTeleport *>(obj))
+		nullkiller->pathfinder->invalidateAll();
+	else
+		nullkiller->pathfinder->invalidateObject(obj);
+
 	if(nullkiller->baseGraph && nullkiller->isObjectGraphAllowed())
 	{
 		nullkiller->baseGraph->removeObject(obj);
@@ -496,6 +534,8 @@ void AIGateway::objectPropertyChanged(const SetObjectProperty * sop)
 
 		if(obj)
 		{
+			nullkiller->pathfinder->invalidateObject(obj);
+
 			if(relations == PlayerRelations::ENEMIES)
 			{
 				//we want to visit objects owned by oppponents
@@ -575,6 +615,12 @@ void AIGateway::initGameInterface(std::shared_ptr<Environment> env, std::shared_
 	myCb->unlockGsWhenWaiting = true;
 
 	nullkiller->init(CB, this);
+
+	if(threatMapGameState)
+		SharedThreatMap::removeUser(threatMapGameState);
+
+	threatMapGameState = myCb->getGameStateID();
+	SharedThreatMap::addUser(threatMapGameState);
 	
 	retrieveVisitableObjs();
 }
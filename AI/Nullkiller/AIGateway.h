@@ -84,6 +84,7 @@ public:
 	std::unique_ptr<boost::thread> makingTurn;
 private:
 	boost::mutex turnInterruptionMutex;
+	uint64_t threatMapGameState; //game state whose shared threat maps are used by this AI, 0 if none
 
 public:
 	ObjectInstanceID selectedObject;
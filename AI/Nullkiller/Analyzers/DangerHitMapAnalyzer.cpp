@@ -9,9 +9,11 @@
 */
 #include "../StdInc.h"
 #include "DangerHitMapAnalyzer.h"
+#include "SharedThreatMap.h"
 
 #include "../Engine/Nullkiller.h"
 #include "../pforeach.h"
+#include "../../../lib/CPlayerState.h"
 #include "../../../lib/CRandomGenerator.h"
 #include "../../../lib/logging/VisualLogger.h"
 
@@ -81,22 +83,16 @@ void DangerHitMapAnalyzer::updateHitMap()
 
 	std::map<PlayerColor, std::map<const CGHeroInstance *, HeroRole>> heroes;
 
-	for(const CGObjectInstance * obj : ai->memory->visitableObjs)
+	// memory of this AI is not used so that threats are the same for all AIs of the team
+	for(const CGHeroInstance * hero : cb->getHeroesInfo(false))
 	{
-		if(obj->ID == Obj::HERO)
-		{
-			auto hero = dynamic_cast<const CGHeroInstance *>(obj);
-
-			heroes[hero->tempOwner][hero] = HeroRole::MAIN;
-		}
-
-		if(obj->ID == Obj::TOWN)
-		{
-			auto town = dynamic_cast<const CGTownInstance *>(obj);
+		heroes[hero->tempOwner][hero] = HeroRole::MAIN;
+	}
 
-			if(town->garrisonHero)
-				heroes[town->garrisonHero->tempOwner][town->garrisonHero] = HeroRole::MAIN;
-		}
+	for(const CGTownInstance * town : cb->getTownsInfo(false))
+	{
+		if(town->garrisonHero)
+			heroes[town->garrisonHero->tempOwner][town->garrisonHero] = HeroRole::MAIN;
 	}
 
 	auto ourTowns = cb->getTownsInfo();
@@ -110,6 +106,14 @@ void DangerHitMapAnalyzer::updateHitMap()
 		hitMap[pos.x][pos.y][pos.z].reset();
 	});
 
+	SharedThreatMap::Key key;
+
+	key.gameState = cb->getGameStateID();
+	key.team = cb->getPlayerTeam(ai->playerID)->id;
+	key.turnLimit = ai->settings->getMainHeroTurnDistanceLimit();
+	key.visibility = SharedThreatMap::visibilityHash(cb, ai->playerID);
+	key.objects = objectsHash();
+
 	for(auto pair : heroes)
 	{
 		if(!pair.first.isValidPlayer())
@@ -118,78 +122,166 @@ void DangerHitMapAnalyzer::updateHitMap()
 		if(ai->cb->getPlayerRelations(ai->playerID, pair.first) != PlayerRelations::ENEMIES)
 			continue;
 
-		PathfinderSettings ps;
+		key.enemy = pair.first;
+		key.enemyHeroes = 0;
 
-		ps.scoutTurnDistanceLimit = ps.mainTurnDistanceLimit = ai->settings->getMainHeroTurnDistanceLimit();
-		ps.useHeroChain = false;
+		for(auto & hero : pair.second)
+		{
+			boost::hash_combine(key.enemyHeroes, hero.first->id.getNum());
+			boost::hash_combine(key.enemyHeroes, std::hash<int3>()(hero.first->visitablePos()));
+			boost::hash_combine(key.enemyHeroes, hero.first->inTownGarrison);
+			boost::hash_combine(key.enemyHeroes, hero.first->movementPointsRemaining());
+			boost::hash_combine(key.enemyHeroes, hero.first->mana);
+			boost::hash_combine(key.enemyHeroes, hero.first->exp);
+			boost::hash_combine(key.enemyHeroes, hero.first->getArmyStrength());
+		}
 
-		ai->pathfinder->updatePaths(pair.second, ps);
+		auto threats = SharedThreatMap::get(key, [this, &pair]()
+		{
+			return calculateEnemyThreats(pair.second);
+		});
+
+		foreach_tile_pos([&](const int3 & pos)
+		{
+			auto & node = hitMap[pos.x][pos.y][pos.z];
+			auto & enemyNode = threats->tiles[pos.x][pos.y][pos.z];
 
-		boost::this_thread::interruption_point();
+			if(enemyNode.maximumDanger.value() > node.maximumDanger.value())
+			{
+				node.maximumDanger = enemyNode.maximumDanger;
+			}
 
-		pforeachTilePaths(mapSize, ai, [&](const int3 & pos, const std::vector<AIPath> & paths)
+			if(enemyNode.fastestDanger.turn < node.fastestDanger.turn
+				|| (enemyNode.fastestDanger.turn == node.fastestDanger.turn && node.fastestDanger.danger < enemyNode.fastestDanger.danger))
+			{
+				node.fastestDanger = enemyNode.fastestDanger;
+			}
+		});
+
+		for(auto & enemyTownThreats : threats->townThreats)
 		{
-			for(const AIPath & path : paths)
+			auto ourTownThreats = townThreats.find(enemyTownThreats.first);
+
+			// heroes of different players never overlap so lists can be simply joined
+			if(ourTownThreats != townThreats.end())
+				vstd::concatenate(ourTownThreats->second, enemyTownThreats.second);
+		}
+
+		for(auto & accessibleTown : threats->oneTurnAccessibleTowns)
+		{
+			if(accessibleTown.obj->getOwner() == ai->playerID)
+				enemyHeroAccessibleObjects.push_back(accessibleTown);
+		}
+	}
+
+	logAi->trace("Danger hit map updated in %ld", timeElapsed(start));
+
+	logHitmap(ai->playerID, *this);
+}
+
+size_t DangerHitMapAnalyzer::objectsHash() const
+{
+	size_t result = 0;
+
+	// towns and guards change owner or army, and heroes of the team block enemies or fight them on the way
+	for(const CGObjectInstance * obj : ai->cb->getAllVisitableObjs())
+	{
+		boost::hash_combine(result, obj->id.getNum());
+		boost::hash_combine(result, obj->tempOwner.getNum());
+		boost::hash_combine(result, std::hash<int3>()(obj->visitablePos()));
+
+		auto armed = dynamic_cast<const CArmedInstance *>(obj);
+
+		if(armed)
+			boost::hash_combine(result, armed->getArmyStrength());
+	}
+
+	return result;
+}
+
+std::shared_ptr<const EnemyThreatMap> DangerHitMapAnalyzer::calculateEnemyThreats(const std::map<const CGHeroInstance *, HeroRole> & heroes) const
+{
+	auto cb = ai->cb.get();
+	auto mapSize = ai->cb->getMapSize();
+	auto result = std::make_shared<EnemyThreatMap>();
+	std::mutex townThreatsMutex;
+
+	result->tiles.resize(boost::extents[mapSize.x][mapSize.y][mapSize.z]);
+
+	PathfinderSettings ps;
+
+	ps.scoutTurnDistanceLimit = ps.mainTurnDistanceLimit = ai->settings->getMainHeroTurnDistanceLimit();
+	ps.useHeroChain = false;
+
+	// own pathfinder keeps result independent of paths this AI calculated before
+	AIPathfinder pathfinder(cb, ai);
+
+	pathfinder.updatePaths(heroes, ps);
+
+	boost::this_thread::interruption_point();
+
+	pforeachTilePaths(mapSize, pathfinder, [&](const int3 & pos, const std::vector<AIPath> & paths)
+	{
+		for(const AIPath & path : paths)
+		{
+			if(path.getFirstBlockedAction())
+				continue;
+
+			auto & node = result->tiles[pos.x][pos.y][pos.z];
+
+			HitMapInfo newThreat;
+
+			newThreat.hero = path.targetHero;
+			newThreat.turn = path.turn();
+			newThreat.danger = path.getHeroStrength();
+
+			if(newThreat.value() > node.maximumDanger.value())
 			{
-				if(path.getFirstBlockedAction())
-					continue;
+				node.maximumDanger = newThreat;
+			}
+
+			if(newThreat.turn < node.fastestDanger.turn
+				|| (newThreat.turn == node.fastestDanger.turn && node.fastestDanger.danger < newThreat.danger))
+			{
+				node.fastestDanger = newThreat;
+			}
 
-				auto & node = hitMap[pos.x][pos.y][pos.z];
+			auto objects = cb->getVisitableObjs(pos, false);
 
-				HitMapInfo newThreat;
+			for(auto obj : objects)
+			{
+				if(obj->ID != Obj::TOWN)
+					continue;
 
-				newThreat.hero = path.targetHero;
-				newThreat.turn = path.turn();
-				newThreat.danger = path.getHeroStrength();
+				// threats are collected for all towns since cached map is shared between players
+				std::lock_guard<std::mutex> lock(townThreatsMutex);
 
-				if(newThreat.value() > node.maximumDanger.value())
+				auto & threats = result->townThreats[obj->id];
+				auto threat = std::find_if(threats.begin(), threats.end(), [&](const HitMapInfo & i) -> bool
+					{
+						return i.hero.hid == path.targetHero->id;
+					});
+
+				if(threat == threats.end())
 				{
-					node.maximumDanger = newThreat;
+					threats.emplace_back();
+					threat = std::prev(threats.end(), 1);
 				}
 
-				if(newThreat.turn < node.fastestDanger.turn
-					|| (newThreat.turn == node.fastestDanger.turn && node.fastestDanger.danger < newThreat.danger))
+				if(newThreat.value() > threat->value())
 				{
-					node.fastestDanger = newThreat;
+					*threat = newThreat;
 				}
 
-				auto objects = cb->getVisitableObjs(pos, false);
-
-				for(auto obj : objects)
+				if(newThreat.turn == 0)
 				{
-					if(obj->ID == Obj::TOWN && obj->getOwner() == ai->playerID)
-					{
-						auto & threats = townThreats[obj->id];
-						auto threat = std::find_if(threats.begin(), threats.end(), [&](const HitMapInfo & i) -> bool
-							{
-								return i.hero.hid == path.targetHero->id;
-							});
-
-						if(threat == threats.end())
-						{
-							threats.emplace_back();
-							threat = std::prev(threats.end(), 1);
-						}
-
-						if(newThreat.value() > threat->value())
-						{
-							*threat = newThreat;
-						}
-
-						if(newThreat.turn == 0)
-						{
-							if(cb->getPlayerRelations(obj->tempOwner, ai->playerID) != PlayerRelations::ENEMIES)
-								enemyHeroAccessibleObjects.emplace_back(path.targetHero, obj);
-						}
-					}
+					result->oneTurnAccessibleTowns.emplace_back(path.targetHero, obj);
 				}
 			}
-		});
-	}
-
-	logAi->trace("Danger hit map updated in %ld", timeElapsed(start));
+		}
+	});
 
-	logHitmap(ai->playerID, *this);
+	return result;
 }
 
 void DangerHitMapAnalyzer::calculateTileOwners()
@@ -15,6 +15,7 @@ namespace NKAI
 {
 
 struct AIPath;
+struct EnemyThreatMap;
 
 struct HitMapInfo
 {
@@ -76,6 +77,10 @@ private:
 	const Nullkiller * ai;
 	std::map<ObjectInstanceID, std::vector<HitMapInfo>> townThreats;
 
+	std::shared_ptr<const EnemyThreatMap> calculateEnemyThreats(const std::map<const CGHeroInstance *, HeroRole> & heroes) const;
+	/// hash of state of objects which affects threats of enemy heroes, part of SharedThreatMap key
+	size_t objectsHash() const;
+
 public:
 	DangerHitMapAnalyzer(const Nullkiller * ai) :ai(ai) {}
 
@@ -0,0 +1,101 @@
+/*
+* SharedThreatMap.cpp, part of VCMI engine
+*
+* Authors: listed in file AUTHORS in main folder
+*
+* License: GNU General Public License v2.0 or later
+* Full text of license available in license.txt file, in main folder
+*
+*/
+#include "../StdInc.h"
+#include "SharedThreatMap.h"
+
+#include "../../../lib/CPlayerState.h"
+
+namespace NKAI
+{
+
+std::mutex SharedThreatMap::cacheMutex;
+std::map<SharedThreatMap::Key, std::shared_ptr<SharedThreatMap::Entry>> SharedThreatMap::cache;
+std::map<uint64_t, int> SharedThreatMap::users;
+
+std::shared_ptr<const EnemyThreatMap> SharedThreatMap::get(const Key & key, const Calculator & calculate)
+{
+	std::shared_ptr<Entry> entry;
+
+	{
+		std::lock_guard<std::mutex> lock(cacheMutex);
+
+		// team only ever requests the latest state of enemy
+		vstd::erase_if(cache, [&key](const std::pair<const Key, std::shared_ptr<Entry>> & cached)
+		{
+			bool outdated = cached.first < key || key < cached.first;
+
+			return cached.first.gameState == key.gameState
+				&& cached.first.team == key.team
+				&& cached.first.enemy == key.enemy
+				&& outdated;
+		});
+
+		auto & cached = cache[key];
+		if(!cached)
+			cached = std::make_shared<Entry>();
+
+		entry = cached;
+	}
+
+	std::lock_guard<std::mutex> lock(entry->calculationMutex);
+
+	// if calculation was interrupted by exception next waiting AI will try again
+	if(!entry->threats)
+		entry->threats = calculate();
+
+	return entry->threats;
+}
+
+void SharedThreatMap::addUser(uint64_t gameState)
+{
+	std::lock_guard<std::mutex> lock(cacheMutex);
+
+	users[gameState]++;
+}
+
+void SharedThreatMap::removeUser(uint64_t gameState)
+{
+	std::lock_guard<std::mutex> lock(cacheMutex);
+
+	if(--users[gameState] > 0)
+		return;
+
+	users.erase(gameState);
+
+	// cached maps point to objects of the game state which is about to be deleted
+	vstd::erase_if(cache, [gameState](const std::pair<const Key, std::shared_ptr<Entry>> & cached)
+	{
+		return cached.first.gameState == gameState;
+	});
+}
+
+void SharedThreatMap::clear()
+{
+	std::lock_guard<std::mutex> lock(cacheMutex);
+
+	cache.clear();
+	users.clear();
+}
+
+size_t SharedThreatMap::size()
+{
+	std::lock_guard<std::mutex> lock(cacheMutex);
+
+	return cache.size();
+}
+
+size_t SharedThreatMap::visibilityHash(const CPlayerSpecificInfoCallback * cb, PlayerColor player)
+{
+	const auto & fow = cb->getPlayerTeam(player)->fogOfWarMap;
+
+	return boost::hash_range(fow.data(), fow.data() + fow.num_elements());
+}
+
+}
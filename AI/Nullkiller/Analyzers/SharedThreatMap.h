@@ -0,0 +1,90 @@
+/*
+* SharedThreatMap.h, part of VCMI engine
+*
+* Authors: listed in file AUTHORS in main folder
+*
+* License: GNU General Public License v2.0 or later
+* Full text of license available in license.txt file, in main folder
+*
+*/
+#pragma once
+
+#include "DangerHitMapAnalyzer.h"
+
+namespace NKAI
+{
+
+/// Danger posed by heroes of one enemy player, as seen by a team with particular fog of war
+struct EnemyThreatMap
+{
+	/// maximum and fastest danger per tile, closestTown is not used
+	boost::multi_array<HitMapNode, 3> tiles;
+	/// threat of every hero to every reached town, regardless of town owner
+	std::map<ObjectInstanceID, std::vector<HitMapInfo>> townThreats;
+	/// towns reachable by enemy hero in current turn
+	std::vector<EnemyHeroAccessibleObject> oneTurnAccessibleTowns;
+};
+
+/// Process-wide cache of enemy threat maps of all Nullkiller instances.
+/// Threats are calculated from game state visible to the team only, so all AIs of a team share the entries.
+/// An entry is reused for as long as enemy heroes, objects they can interact with and visibility stay the same,
+/// which spans many hit map updates of a turn and turns of enemies that did not move. Cached maps are immutable,
+/// every AI merges them into its own hit map
+class DLL_EXPORT SharedThreatMap
+{
+public:
+	struct Key
+	{
+		/// CGameState::gameStateID, cached maps point to objects of that game state
+		uint64_t gameState;
+		/// team of observer, objects of the team are not dangerous to its heroes
+		TeamID team;
+		PlayerColor enemy;
+		uint8_t turnLimit;
+		/// hash of fog of war of the team
+		size_t visibility;
+		/// hash of identity, position, movement and army of every enemy hero
+		size_t enemyHeroes;
+		/// hash of ownership, position and army of objects visible to the team
+		size_t objects;
+
+		bool operator<(const Key & other) const
+		{
+			return std::tie(gameState, team, enemy, turnLimit, visibility, enemyHeroes, objects)
+				< std::tie(other.gameState, other.team, other.enemy, other.turnLimit, other.visibility, other.enemyHeroes, other.objects);
+		}
+	};
+
+	using Calculator = std::function<std::shared_ptr<const EnemyThreatMap>()>;
+
+	/// returns cached threats or calculates them. Concurrent requests for the same key wait for single calculation.
+	/// Drops outdated entries of the same team and enemy
+	static std::shared_ptr<const EnemyThreatMap> get(const Key & key, const Calculator & calculate);
+
+	/// registers AI playing in the game state, called when AI is initialized
+	static void addUser(uint64_t gameState);
+	/// drops entries of the game state when its last AI is destroyed, entries of other games are kept
+	static void removeUser(uint64_t gameState);
+
+	/// drops all entries and users, used by tests
+	static void clear();
+
+	static size_t size();
+
+	/// hash of fog of war of player's team
+	static size_t visibilityHash(const CPlayerSpecificInfoCallback * cb, PlayerColor player);
+
+private:
+	struct Entry
+	{
+		std::mutex calculationMutex;
+		std::shared_ptr<const EnemyThreatMap> threats;
+	};
+
+	static std::mutex cacheMutex;
+	static std::map<Key, std::shared_ptr<Entry>> cache;
+	/// number of living AIs of every game state
+	static std::map<uint64_t, int> users;
+};
+
+}
@@ -30,6 +30,10 @@ ui64 FuzzyHelper::evaluateDanger(const int3 & tile, const CGHeroInstance * visit
 	ui64 objectDanger = 0;
 	ui64 guardDanger = 0;
 
+	// memory of this AI is not shared with allies, so danger for enemy heroes only uses what whole team can see.
+	// This keeps enemy threats same for all AIs of the team, see SharedThreatMap
+	bool useMemory = !visitor || cb->getPlayerRelations(visitor->tempOwner, ai->playerID) != PlayerRelations::ENEMIES;
+
 	auto visitableObjects = cb->getVisitableObjs(tile);
 	// in some scenarios hero happens to be "under" the object (eg town). Then we consider ONLY the hero.
 	if(vstd::contains_if(visitableObjects, objWithID<Obj::HERO>))
@@ -42,7 +46,7 @@ ui64 FuzzyHelper::evaluateDanger(const int3 & tile, const CGHeroInstance * visit
 
 	if(const CGObjectInstance * dangerousObject = vstd::backOrNull(visitableObjects))
 	{
-		objectDanger = evaluateDanger(dangerousObject); //unguarded objects can also be dangerous or unhandled
+		objectDanger = evaluateDanger(dangerousObject, useMemory); //unguarded objects can also be dangerous or unhandled
 
 		if(objWithID<Obj::HERO>(dangerousObject))
 		{
@@ -50,7 +54,7 @@ ui64 FuzzyHelper::evaluateDanger(const int3 & tile, const CGHeroInstance * visit
 
 			if(hero->visitedTown && !hero->visitedTown->garrisonHero)
 			{
-				objectDanger += evaluateDanger(hero->visitedTown.get());
+				objectDanger += evaluateDanger(hero->visitedTown.get(), useMemory);
 			}
 		}
 
@@ -64,7 +68,7 @@ ui64 FuzzyHelper::evaluateDanger(const int3 & tile, const CGHeroInstance * visit
 				objectDanger *= tacticalAdvantage; //this line tends to go infinite for allied towns (?)
 			}
 		}
-		if(dangerousObject->ID == Obj::SUBTERRANEAN_GATE)
+		if(useMemory && dangerousObject->ID == Obj::SUBTERRANEAN_GATE)
 		{
 			//check guard on the other side of the gate
 			auto it = ai->memory->knownSubterraneanGates.find(dangerousObject);
@@ -100,6 +104,11 @@ ui64 FuzzyHelper::evaluateDanger(const int3 & tile, const CGHeroInstance * visit
 }
 
 ui64 FuzzyHelper::evaluateDanger(const CGObjectInstance * obj)
+{
+	return evaluateDanger(obj, true);
+}
+
+ui64 FuzzyHelper::evaluateDanger(const CGObjectInstance * obj, bool useMemory)
 {
 	auto cb = ai->cb.get();
 
@@ -135,7 +144,7 @@ ui64 FuzzyHelper::evaluateDanger(const CGObjectInstance * obj)
 	case Obj::ARTIFACT:
 	case Obj::RESOURCE:
 	{
-		if(!vstd::contains(ai->memory->alreadyVisited, obj))
+		if(!useMemory || !vstd::contains(ai->memory->alreadyVisited, obj))
 			return 0;
 		[[fallthrough]];
 	}
@@ -21,6 +21,8 @@ private:
 	const Nullkiller * ai;
 	TacticalAdvantageEngine tacticalAdvantageEngine;
 
+	ui64 evaluateDanger(const CGObjectInstance * obj, bool useMemory);
+
 public:
 	FuzzyHelper(const Nullkiller * ai): ai(ai) {}
 
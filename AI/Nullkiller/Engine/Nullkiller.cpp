@@ -224,6 +224,7 @@ void Nullkiller::resetAiState()
 	dangerHitMap->reset();
 	useHeroChain = true;
 	objectClusterizer->reset();
+	pathfinder->invalidateAll();
 
 	if(!baseGraph && isObjectGraphAllowed())
 	{
@@ -25,7 +25,7 @@
 namespace NKAI
 {
 
-std::shared_ptr<boost::multi_array<AIPathNode, 4>> AISharedStorage::shared;
+std::shared_ptr<AISharedStorage::SparseNodes> AISharedStorage::shared;
 uint32_t AISharedStorage::version = 0;
 boost::mutex AISharedStorage::locker;
 std::set<int3> committedTiles;
@@ -39,27 +39,19 @@ const uint64_t CHAIN_MAX_DEPTH = 4;
 
 const bool DO_NOT_SAVE_TO_COMMITTED_TILES = false;
 
-AISharedStorage::AISharedStorage(int3 sizes)
+AISharedStorage::SparseNodes::SparseNodes(const int3 & sizes)
+	: sizes(sizes), tileBlocks(sizes.z * sizes.x * sizes.y)
 {
-	if(!shared){
-		shared.reset(new boost::multi_array<AIPathNode, 4>(
-			boost::extents[sizes.z][sizes.x][sizes.y][AIPathfinding::NUM_CHAINS]));
+	for(auto & block : tileBlocks)
+		block.store(0, std::memory_order_relaxed);
+}
 
-		nodes = shared;
+AISharedStorage::AISharedStorage(int3 sizes)
+{
+	if(!shared)
+		shared = std::make_shared<SparseNodes>(sizes);
 
-		foreach_tile_pos([&](const int3 & pos)
-			{
-				for(auto i = 0; i < AIPathfinding::NUM_CHAINS; i++)
-				{
-					auto & node = get(pos)[i];
-						
-					node.version = -1;
-					node.coord = pos;
-				}
-			});
-	}
-	else
-		nodes = shared;
+	nodes = shared;
 }
 
 AISharedStorage::~AISharedStorage()
@@ -71,6 +63,38 @@ AISharedStorage::~AISharedStorage()
 	}
 }
 
+boost::iterator_range<AIPathNode *> AISharedStorage::getOrAllocate(int3 tile)
+{
+	std::atomic<uint32_t> & block = nodes->tileBlock(tile);
+
+	if(block.load(std::memory_order_acquire) == 0)
+	{
+		auto nodeBlock = nodes->blocks.grow_by(1);
+
+		for(AIPathNode & node : *nodeBlock)
+		{
+			node.version = -1;
+			node.coord = tile;
+		}
+
+		// if other task has allocated nodes for this tile meanwhile our block just stays unused until reset
+		uint32_t expected = 0;
+		block.compare_exchange_strong(expected, static_cast<uint32_t>(nodeBlock - nodes->blocks.begin()) + 1, std::memory_order_acq_rel);
+	}
+
+	return get(tile);
+}
+
+void AISharedStorage::reset()
+{
+	for(auto & block : nodes->tileBlocks)
+		block.store(0, std::memory_order_relaxed);
+
+	// clear alone keeps allocated segments
+	nodes->blocks.clear();
+	nodes->blocks.shrink_to_fit();
+}
+
 void AIPathNode::addSpecialAction(std::shared_ptr<const SpecialAction> action)
 {
 	if(!specialAction)
@@ -106,12 +130,50 @@ void AINodeStorage::initialize(const PathfinderOptions & options, const CGameSta
 	if(heroChainPass != EHeroChainPass::INITIAL)
 		return;
 
-	AISharedStorage::version++;
-
 	//TODO: fix this code duplication with NodeStorage::initialize, problem is to keep `resetTile` inline
 	const PlayerColor fowPlayer = ai->playerID;
 	const auto & fow = static_cast<const CGameInfoCallback *>(gs)->getPlayerTeam(fowPlayer)->fogOfWarMap;
 	const int3 sizes = gs->getMapSize();
+	const bool useFlying = options.useFlying;
+	const bool useWaterWalking = options.useWaterWalking;
+	const PlayerColor player = playerID;
+
+	auto updateTile = [&](const int3 & pos)
+	{
+		const TerrainTile & tile = gs->map->getTile(pos);
+		if (!tile.terType->isPassable())
+			return;
+
+		if (tile.terType->isWater())
+		{
+			resetTile(pos, ELayer::SAIL, PathfinderUtil::evaluateAccessibility<ELayer::SAIL>(pos, tile, fow, player, gs));
+			if (useFlying)
+				resetTile(pos, ELayer::AIR, PathfinderUtil::evaluateAccessibility<ELayer::AIR>(pos, tile, fow, player, gs));
+			if (useWaterWalking)
+				resetTile(pos, ELayer::WATER, PathfinderUtil::evaluateAccessibility<ELayer::WATER>(pos, tile, fow, player, gs));
+		}
+		else
+		{
+			resetTile(pos, ELayer::LAND, PathfinderUtil::evaluateAccessibility<ELayer::LAND>(pos, tile, fow, player, gs));
+			if (useFlying)
+				resetTile(pos, ELayer::AIR, PathfinderUtil::evaluateAccessibility<ELayer::AIR>(pos, tile, fow, player, gs));
+		}
+	};
+
+	// when only some heroes are recalculated nodes of remaining ones must stay valid
+	// and accessibility of the rest of the map is known from previous run
+	if(firstUpdatedActor != 0)
+	{
+		for(const int3 & pos : changedTiles)
+			updateTile(pos);
+
+		changedTiles.clear();
+
+		return;
+	}
+
+	AISharedStorage::version++;
+	nodes.reset();
 
 	//Each thread gets different x, but an array of y located next to each other in memory
 
@@ -121,32 +183,11 @@ void AINodeStorage::initialize(const PathfinderOptions & options, const CGameSta
 
 		for(pos.z = 0; pos.z < sizes.z; ++pos.z)
 		{
-			const bool useFlying = options.useFlying;
-			const bool useWaterWalking = options.useWaterWalking;
-			const PlayerColor player = playerID;
-
 			for(pos.x = r.begin(); pos.x != r.end(); ++pos.x)
 			{
 				for(pos.y = 0; pos.y < sizes.y; ++pos.y)
 				{
-					const TerrainTile & tile = gs->map->getTile(pos);
-					if (!tile.terType->isPassable())
-						continue;
-
-					if (tile.terType->isWater())
-					{
-						resetTile(pos, ELayer::SAIL, PathfinderUtil::evaluateAccessibility<ELayer::SAIL>(pos, tile, fow, player, gs));
-						if (useFlying)
-							resetTile(pos, ELayer::AIR, PathfinderUtil::evaluateAccessibility<ELayer::AIR>(pos, tile, fow, player, gs));
-						if (useWaterWalking)
-							resetTile(pos, ELayer::WATER, PathfinderUtil::evaluateAccessibility<ELayer::WATER>(pos, tile, fow, player, gs));
-					}
-					else
-					{
-						resetTile(pos, ELayer::LAND, PathfinderUtil::evaluateAccessibility<ELayer::LAND>(pos, tile, fow, player, gs));
-						if (useFlying)
-							resetTile(pos, ELayer::AIR, PathfinderUtil::evaluateAccessibility<ELayer::AIR>(pos, tile, fow, player, gs));
-					}
+					updateTile(pos);
 				}
 			}
 		}
@@ -162,6 +203,41 @@ void AINodeStorage::clear()
 	heroChainMaxTurns = 1;
 	turnDistanceLimit[HeroRole::MAIN] = 255;
 	turnDistanceLimit[HeroRole::SCOUT] = 255;
+	firstUpdatedActor = 0;
+	changedTiles.clear();
+}
+
+void AINodeStorage::resetHeroes(const std::set<const CGHeroInstance *> & heroes, const std::set<int3> & changedTiles)
+{
+	assert(heroChainPass == EHeroChainPass::INITIAL);
+
+	nodes.iterateAllNodes([&heroes](AIPathNode & node)
+		{
+			if(node.version == AISharedStorage::version && node.actor && vstd::contains(heroes, node.actor->hero))
+				node.version = AISharedStorage::version - 1;
+		});
+
+	vstd::erase_if(actors, [&heroes](const std::shared_ptr<ChainActor> & actor) -> bool
+		{
+			return vstd::contains(heroes, actor->hero);
+		});
+
+	firstUpdatedActor = actors.size();
+	this->changedTiles = changedTiles;
+}
+
+void AINodeStorage::getHeroesReachingTile(const int3 & tile, std::set<const CGHeroInstance *> & result) const
+{
+	for(const AIPathNode & node : nodes.get(tile))
+	{
+		if(node.version == AISharedStorage::version
+			&& node.action != EPathNodeAction::UNKNOWN
+			&& node.actor
+			&& node.actor->hero)
+		{
+			result.insert(node.actor->hero);
+		}
+	}
 }
 
 std::optional<AIPathNode *> AINodeStorage::getOrCreateNode(
@@ -171,13 +247,14 @@ std::optional<AIPathNode *> AINodeStorage::getOrCreateNode(
 {
 	int bucketIndex = ((uintptr_t)actor + static_cast<uint32_t>(layer)) % AIPathfinding::BUCKET_COUNT;
 	int bucketOffset = bucketIndex * AIPathfinding::BUCKET_SIZE;
-	auto chains = nodes.get(pos);
 
 	if(blocked(pos, layer))
 	{
 		return std::nullopt;
 	}
 
+	auto chains = nodes.getOrAllocate(pos);
+
 	for(auto i = AIPathfinding::BUCKET_SIZE - 1; i >= 0; i--)
 	{
 		AIPathNode & node = chains[i + bucketOffset];
@@ -212,9 +289,9 @@ std::vector<CGPathNode *> AINodeStorage::getInitialNodes()
 
 	std::vector<CGPathNode *> initialNodes;
 
-	for(auto actorPtr : actors)
+	for(size_t i = firstUpdatedActor; i < actors.size(); i++)
 	{
-		ChainActor * actor = actorPtr.get();
+		ChainActor * actor = actors[i].get();
 
 		auto allocated = getOrCreateNode(actor->initialPosition, actor->layer, actor);
 
@@ -455,6 +532,15 @@ bool AINodeStorage::calculateHeroChainFinal()
 	return heroChain.size();
 }
 
+void AINodeStorage::logNodesAllocation() const
+{
+	logAi->trace(
+		"Allocated chain nodes for %d of %d tiles, %d KB",
+		nodes.getAllocatedTilesCount(),
+		nodes.getTilesCount(),
+		nodes.getAllocatedTilesCount() * sizeof(AIPathNode) * AIPathfinding::NUM_CHAINS / 1024);
+}
+
 struct DelayedWork
 {
 	AIPathNode * carrier;
@@ -966,7 +1052,17 @@ void AINodeStorage::setHeroes(std::map<const CGHeroInstance *, HeroRole> heroes)
 			continue;
 		}
 
-		uint64_t mask = FirstActorMask << actors.size();
+		uint64_t usedMasks = 0;
+
+		for(auto & actor : actors)
+			usedMasks |= actor->chainMask;
+
+		// actors of recalculated heroes could be removed so first free bit is used instead of actor count
+		uint64_t mask = FirstActorMask;
+
+		while(mask & usedMasks)
+			mask <<= 1;
+
 		auto actor = std::make_shared<HeroActor>(hero.first, hero.second, mask, ai);
 
 		if(actor->hero->tempOwner != ai->playerID)
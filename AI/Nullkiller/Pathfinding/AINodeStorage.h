@@ -149,10 +149,29 @@ enum EHeroChainPass
 
 class AISharedStorage
 {
-	// 1-3 - position on map[z][x][y]
-	// 4 - chain + layer (normal, battle, spellcast and combinations, water, air)
-	static std::shared_ptr<boost::multi_array<AIPathNode, 4>> shared;
-	std::shared_ptr<boost::multi_array<AIPathNode, 4>> nodes;
+	using NodeBlock = std::array<AIPathNode, AIPathfinding::NUM_CHAINS>;
+
+	/// chain nodes are allocated only for tiles reached by pathfinder
+	struct SparseNodes
+	{
+		int3 sizes;
+		/// index of block in blocks + 1 for every tile on map[z][x][y], 0 if tile was not reached.
+		/// Atomic because hero chain tasks may reach the same tile concurrently
+		std::vector<std::atomic<uint32_t>> tileBlocks;
+		/// concurrent_vector keeps addresses of existing blocks stable while hero chain tasks allocate new ones
+		tbb::concurrent_vector<NodeBlock> blocks;
+
+		SparseNodes(const int3 & sizes);
+
+		STRONG_INLINE
+		std::atomic<uint32_t> & tileBlock(const int3 & tile)
+		{
+			return tileBlocks[(tile.z * sizes.x + tile.x) * sizes.y + tile.y];
+		}
+	};
+
+	static std::shared_ptr<SparseNodes> shared;
+	std::shared_ptr<SparseNodes> nodes;
 public:
 	static boost::mutex locker;
 	static uint32_t version;
@@ -160,10 +179,41 @@ public:
 	AISharedStorage(int3 mapSize);
 	~AISharedStorage();
 
+	/// nodes of the tile, empty if nothing reached the tile since last reset
 	STRONG_INLINE
-	boost::detail::multi_array::sub_array<AIPathNode, 1> get(int3 tile) const
+	boost::iterator_range<AIPathNode *> get(int3 tile) const
+	{
+		uint32_t block = nodes->tileBlock(tile).load(std::memory_order_acquire);
+
+		if(block == 0)
+			return boost::iterator_range<AIPathNode *>();
+
+		auto & nodeBlock = nodes->blocks[block - 1];
+
+		return boost::make_iterator_range(nodeBlock.data(), nodeBlock.data() + nodeBlock.size());
+	}
+
+	/// same as get but allocates nodes for the tile if needed. Safe to call concurrently for different tiles
+	boost::iterator_range<AIPathNode *> getOrAllocate(int3 tile);
+
+	/// releases memory of all nodes, called when node version changes so they are all invalid anyway
+	void reset();
+
+	size_t getAllocatedTilesCount() const
+	{
+		return nodes->blocks.size();
+	}
+
+	size_t getTilesCount() const
+	{
+		return nodes->tileBlocks.size();
+	}
+
+	template<typename Fn>
+	void iterateAllNodes(Fn fn) const
 	{
-		return (*nodes)[tile.z][tile.x][tile.y];
+		for(auto & nodeBlock : nodes->blocks)
+			std::for_each(nodeBlock.begin(), nodeBlock.end(), fn);
 	}
 };
 
@@ -185,6 +235,10 @@ private:
 	int heroChainMaxTurns;
 	PlayerColor playerID;
 	uint8_t turnDistanceLimit[2];
+	/// actors starting from this index are searched by next pathfinder run, nodes of others are kept
+	size_t firstUpdatedActor = 0;
+	/// tiles whose accessibility is reevaluated by incremental run, accessibility of other tiles is kept
+	std::set<int3> changedTiles;
 
 public:
 	/// more than 1 chain layer for each hero allows us to have more than 1 path to each tile so we can chose more optimal one.	
@@ -281,8 +335,14 @@ public:
 		const std::set<const CGObjectInstance *> & visitableObjs);
 	const std::set<const CGHeroInstance *> getAllHeroes() const;
 	void clear();
+	/// Drops actors and nodes of given heroes so that next pathfinder run recalculates only them
+	/// while keeping paths of other heroes intact. Not applicable for hero chain.
+	/// Only accessibility of changedTiles is reevaluated by next initialize
+	void resetHeroes(const std::set<const CGHeroInstance *> & heroes, const std::set<int3> & changedTiles);
+	void getHeroesReachingTile(const int3 & tile, std::set<const CGHeroInstance *> & result) const;
 	bool calculateHeroChain();
 	bool calculateHeroChainFinal();
+	void logNodesAllocation() const;
 
 	uint64_t evaluateArmyLoss(const CGHeroInstance * hero, uint64_t armyValue, uint64_t danger) const;
 
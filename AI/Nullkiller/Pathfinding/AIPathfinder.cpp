@@ -19,14 +19,125 @@ namespace NKAI
 
 std::map<ObjectInstanceID, std::unique_ptr<GraphPaths>>  AIPathfinder::heroGraphs;
 
-AIPathfinder::AIPathfinder(CPlayerSpecificInfoCallback * cb, Nullkiller * ai)
-	:cb(cb), ai(ai)
+HeroPathfinderState::HeroPathfinderState(const CGHeroInstance * hero, HeroRole role)
+	:position(hero->visitablePos()),
+	movementPoints(hero->movementPointsRemaining()),
+	mana(hero->mana),
+	armyStrength(hero->getArmyStrength()),
+	bonusVersion(hero->getTreeVersion()),
+	role(role)
+{
+}
+
+AIPathfinder::AIPathfinder(CPlayerSpecificInfoCallback * cb, const Nullkiller * ai)
+	:cb(cb), ai(ai), calculatedVersion(0), graphsUpToDate(false), invalidatedAll(true)
 {
 }
 
 void AIPathfinder::init()
 {
 	storage.reset();
+	invalidateAll();
+}
+
+void AIPathfinder::invalidateTiles(const std::vector<int3> & tiles)
+{
+	boost::lock_guard<boost::mutex> lock(invalidationMutex);
+
+	invalidatedTiles.insert(tiles.begin(), tiles.end());
+}
+
+void AIPathfinder::invalidateObject(const CGObjectInstance * obj)
+{
+	std::vector<int3> tiles;
+
+	// object may guard or block passage through tiles around its visitable position
+	for(const int3 & dir : int3::getDirs())
+	{
+		if(cb->isInTheMap(obj->visitablePos() + dir))
+			tiles.push_back(obj->visitablePos() + dir);
+	}
+
+	tiles.push_back(obj->visitablePos());
+
+	for(const int3 & tile : obj->getBlockedPos())
+		tiles.push_back(tile);
+
+	invalidateTiles(tiles);
+}
+
+void AIPathfinder::invalidateAll()
+{
+	boost::lock_guard<boost::mutex> lock(invalidationMutex);
+
+	invalidatedTiles.clear();
+	invalidatedAll = true;
+}
+
+bool AIPathfinder::getInvalidatedHeroes(
+	const std::map<const CGHeroInstance *, HeroRole> & heroes,
+	PathfinderSettings pathfinderSettings,
+	std::set<const CGHeroInstance *> & result)
+{
+	std::set<int3> tiles;
+	bool all;
+
+	{
+		boost::lock_guard<boost::mutex> lock(invalidationMutex);
+
+		tiles.swap(invalidatedTiles);
+		all = invalidatedAll;
+		invalidatedAll = false;
+	}
+
+	// graph paths go far beyond pathfinder limits so they are affected by any change on map
+	if(all || !tiles.empty())
+		graphsUpToDate = false;
+
+	pendingTiles.insert(tiles.begin(), tiles.end());
+
+	// hero chain mixes armies of all heroes so any change requires full recalculation
+	if(all
+		|| !storage
+		|| pathfinderSettings.useHeroChain
+		|| calculatedSettings.useHeroChain
+		|| !(pathfinderSettings == calculatedSettings)
+		|| calculatedVersion != AISharedStorage::version)
+	{
+		return false;
+	}
+
+	for(auto & hero : heroes)
+	{
+		auto calculated = calculatedHeroes.find(hero.first);
+
+		if(calculated == calculatedHeroes.end()
+			|| !(calculated->second == HeroPathfinderState(hero.first, hero.second))
+			|| hero.first->inTownGarrison)
+		{
+			result.insert(hero.first);
+		}
+	}
+
+	for(auto & hero : calculatedHeroes)
+	{
+		if(!vstd::contains(heroes, hero.first))
+			result.insert(hero.first);
+	}
+
+	// paths of a hero may change only if the hero reached changed tile or some tile next to it
+	for(const int3 & tile : tiles)
+	{
+		storage->getHeroesReachingTile(tile, result);
+
+		for(const int3 & dir : int3::getDirs())
+		{
+			if(cb->isInTheMap(tile + dir))
+				storage->getHeroesReachingTile(tile + dir, result);
+		}
+	}
+
+	return true;
 }
 
 bool AIPathfinder::isTileAccessible(const HeroPtr & hero, const int3 & tile) const
@@ -75,15 +186,60 @@ void AIPathfinder::calculatePathInfo(std::vector<AIPath> & result, const int3 &
 
 void AIPathfinder::updatePaths(const std::map<const CGHeroInstance *, HeroRole> & heroes, PathfinderSettings pathfinderSettings)
 {
+	std::set<const CGHeroInstance *> invalidatedHeroes;
+	bool recalculateAll = !getInvalidatedHeroes(heroes, pathfinderSettings, invalidatedHeroes)
+		|| invalidatedHeroes.size() >= calculatedHeroes.size();
+
 	if(!storage)
 	{
 		storage.reset(new AINodeStorage(ai, cb->getMapSize()));
 	}
 
 	auto start = std::chrono::high_resolution_clock::now();
+
+	if(!recalculateAll && invalidatedHeroes.empty())
+	{
+		logAi->debug("Paths are up to date");
+
+		return;
+	}
+
+	// state is restored only after successful calculation so interrupted update leads to full recalculation next time
+	calculatedHeroes.clear();
+	calculatedSettings = pathfinderSettings;
+	calculatedVersion = 0;
+	graphsUpToDate = false;
+
+	if(!recalculateAll)
+	{
+		logAi->debug("Recalculate paths of %d heroes", invalidatedHeroes.size());
+
+		std::map<const CGHeroInstance *, HeroRole> updatedHeroes;
+
+		for(auto hero : invalidatedHeroes)
+		{
+			if(vstd::contains(heroes, hero))
+				updatedHeroes[hero] = heroes.at(hero);
+		}
+
+		storage->resetHeroes(invalidatedHeroes, pendingTiles);
+		pendingTiles.clear();
+		storage->setHeroes(updatedHeroes);
+
+		auto config = std::make_shared<AIPathfinding::AIPathfinderConfig>(cb, ai, storage, pathfinderSettings.allowBypassObjects);
+
+		cb->calculatePaths(config);
+		rememberCalculatedHeroes(heroes);
+
+		logAi->trace("Recalculated paths in %ld", timeElapsed(start));
+
+		return;
+	}
+
 	logAi->debug("Recalculate all paths");
 	int pass = 0;
 
+	pendingTiles.clear();
 	storage->clear();
 	storage->setHeroes(heroes);
 	storage->setScoutTurnDistanceLimit(pathfinderSettings.scoutTurnDistanceLimit);
@@ -106,6 +262,7 @@ void AIPathfinder::updatePaths(const std::map<const CGHeroInstance *, HeroRole>
 
 	if(!pathfinderSettings.useHeroChain)
 	{
+		rememberCalculatedHeroes(heroes);
 		logAi->trace("Recalculated paths in %ld", timeElapsed(start));
 
 		return;
@@ -141,7 +298,17 @@ void AIPathfinder::updatePaths(const std::map<const CGHeroInstance *, HeroRole>
 		}
 	} while(storage->increaseHeroChainTurnLimit());
 
+	rememberCalculatedHeroes(heroes);
 	logAi->trace("Recalculated paths in %ld", timeElapsed(start));
+	storage->logNodesAllocation();
+}
+
+void AIPathfinder::rememberCalculatedHeroes(const std::map<const CGHeroInstance *, HeroRole> & heroes)
+{
+	for(auto & hero : heroes)
+		calculatedHeroes.emplace(hero.first, HeroPathfinderState(hero.first, hero.second));
+
+	calculatedVersion = AISharedStorage::version;
 }
 
 void AIPathfinder::updateGraphs(
@@ -152,7 +319,20 @@ void AIPathfinder::updateGraphs(
 	auto start = std::chrono::high_resolution_clock::now();
 	std::vector<const CGHeroInstance *> heroesVector;
 
+	bool sameHeroes = heroGraphs.size() == heroes.size();
+
+	for(auto & hero : heroes)
+		sameHeroes = sameHeroes && vstd::contains(heroGraphs, hero.first->id);
+
+	if(graphsUpToDate && sameHeroes && graphScanDepth == std::make_pair(mainScanDepth, scoutScanDepth))
+	{
+		logAi->trace("Graph paths are up to date");
+
+		return;
+	}
+
 	heroGraphs.clear();
+	graphsUpToDate = false;
 
 	for(auto hero : heroes)
 	{
@@ -182,6 +362,9 @@ void AIPathfinder::updateGraphs(
 		}
 	}
 
+	graphsUpToDate = true;
+	graphScanDepth = std::make_pair(mainScanDepth, scoutScanDepth);
+
 	logAi->trace("Graph paths updated in %lld", timeElapsed(start));
 }
 
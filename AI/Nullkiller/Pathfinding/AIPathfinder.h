@@ -33,6 +33,38 @@ struct PathfinderSettings
 		mainTurnDistanceLimit(255),
 		allowBypassObjects(true)
 	{ }
+
+	bool operator==(const PathfinderSettings & other) const
+	{
+		return useHeroChain == other.useHeroChain
+			&& scoutTurnDistanceLimit == other.scoutTurnDistanceLimit
+			&& mainTurnDistanceLimit == other.mainTurnDistanceLimit
+			&& allowBypassObjects == other.allowBypassObjects;
+	}
+};
+
+/// Everything about a hero that affects its paths. Paths of the hero are recalculated only if this changes
+/// or some tile next to area reachable by the hero was invalidated
+struct HeroPathfinderState
+{
+	int3 position;
+	int movementPoints;
+	int mana;
+	uint64_t armyStrength;
+	int64_t bonusVersion;
+	HeroRole role;
+
+	HeroPathfinderState(const CGHeroInstance * hero, HeroRole role);
+
+	bool operator==(const HeroPathfinderState & other) const
+	{
+		return position == other.position
+			&& movementPoints == other.movementPoints
+			&& mana == other.mana
+			&& armyStrength == other.armyStrength
+			&& bonusVersion == other.bonusVersion
+			&& role == other.role;
+	}
 };
 
 class AIPathfinder
@@ -40,11 +72,32 @@ class AIPathfinder
 private:
 	std::shared_ptr<AINodeStorage> storage;
 	CPlayerSpecificInfoCallback * cb;
-	Nullkiller * ai;
+	const Nullkiller * ai;
 	static std::map<ObjectInstanceID, std::unique_ptr<GraphPaths>>  heroGraphs;
 
+	/// state of storage after last updatePaths, used to recalculate only invalidated heroes
+	std::map<const CGHeroInstance *, HeroPathfinderState> calculatedHeroes;
+	PathfinderSettings calculatedSettings;
+	uint32_t calculatedVersion;
+	bool graphsUpToDate;
+	std::pair<uint8_t, uint8_t> graphScanDepth;
+
+	/// tiles changed since last updatePaths, filled from network thread
+	boost::mutex invalidationMutex;
+	std::set<int3> invalidatedTiles;
+	bool invalidatedAll;
+	/// tiles changed since last full recalculation whose accessibility is not yet updated in storage
+	std::set<int3> pendingTiles;
+
+	/// returns false if all paths have to be recalculated
+	bool getInvalidatedHeroes(
+		const std::map<const CGHeroInstance *, HeroRole> & heroes,
+		PathfinderSettings pathfinderSettings,
+		std::set<const CGHeroInstance *> & result);
+	void rememberCalculatedHeroes(const std::map<const CGHeroInstance *, HeroRole> & heroes);
+
 public:
-	AIPathfinder(CPlayerSpecificInfoCallback * cb, Nullkiller * ai);
+	AIPathfinder(CPlayerSpecificInfoCallback * cb, const Nullkiller * ai);
 	void calculatePathInfo(std::vector<AIPath> & paths, const int3 & tile, bool includeGraph = false) const;
 	bool isTileAccessible(const HeroPtr & hero, const int3 & tile) const;
 	void updatePaths(const std::map<const CGHeroInstance *, HeroRole> & heroes, PathfinderSettings pathfinderSettings);
@@ -52,6 +105,11 @@ public:
 	void calculateQuickPathsWithBlocker(std::vector<AIPath> & result, const std::vector<const CGHeroInstance *> & heroes, const int3 & tile);
 	void init();
 
+	/// marks tiles whose accessibility, guards or objects have changed
+	void invalidateTiles(const std::vector<int3> & tiles);
+	void invalidateObject(const CGObjectInstance * obj);
+	void invalidateAll();
+
 	std::shared_ptr<AINodeStorage>getStorage()
 	{
 		return storage;
@@ -29,7 +29,7 @@ namespace AIPathfinding
 	public:
 		AIPathfinderConfig(
 			CPlayerSpecificInfoCallback * cb,
-			Nullkiller * ai,
+			const Nullkiller * ai,
 			std::shared_ptr<AINodeStorage> nodeStorage,
 			bool allowBypassObjects);
 
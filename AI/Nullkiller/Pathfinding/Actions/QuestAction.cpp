@@ -35,7 +35,7 @@ namespace AIPathfinding
 			return dynamic_cast<const IQuestObject *>(questInfo.obj)->checkQuest(hero);
 		}
 
-		auto notActivated = !questInfo.obj->wasVisited(ai->playerID)
+		auto notActivated = !questInfo.obj->wasVisited(hero->getOwner())
 			&& !questInfo.quest->activeForPlayers.count(hero->getOwner());
 		
 		return notActivated
@@ -19,7 +19,7 @@ namespace AIPathfinding
 {
 	AILayerTransitionRule::AILayerTransitionRule(
 		CPlayerSpecificInfoCallback * cb,
-		Nullkiller * ai,
+		const Nullkiller * ai,
 		std::shared_ptr<AINodeStorage> nodeStorage)
 		:cb(cb), ai(ai), nodeStorage(nodeStorage)
 	{
@@ -175,15 +175,15 @@ namespace AIPathfinding
 		const PathNodeInfo & source) const
 	{
 		std::shared_ptr<const VirtualBoatAction> virtualBoat;
+		const CGHeroInstance * hero = nodeStorage->getHero(source.node);
 
-		if(vstd::contains(virtualBoats, destination.coord))
+		// boats are built in shipyards known to this AI and paid from its resources, heroes of other players can not use them
+		if(hero->tempOwner == ai->playerID && vstd::contains(virtualBoats, destination.coord))
 		{
 			virtualBoat = virtualBoats.at(destination.coord);
 		}
 		else
 		{
-			const CGHeroInstance * hero = nodeStorage->getHero(source.node);
-
 			if(vstd::contains(summonableVirtualBoats, hero)
 				&& summonableVirtualBoats.at(hero)->canAct(ai, nodeStorage->getAINode(source.node)))
 			{
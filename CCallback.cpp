@@ -245,15 +245,7 @@ bool CCallback::visitTownBuilding(const CGTownInstance *town, BuildingID buildin
 	return true;
 }
 
-void CBattleCallback::battleMakeSpellAction(const BattleID & battleID, const BattleAction & action)
-{
-	assert(action.actionType == EActionType::HERO_SPELL);
-	MakeAction mca(action);
-	mca.battleID = battleID;
-	sendRequest(mca);
-}
-
-int CBattleCallback::sendRequest(const CPackForServer & request)
+int CClientBattleCallback::sendRequest(const CPackForServer & request)
 {
 	int requestID = cl->sendRequest(request, *getPlayerID());
 	if(waitTillRealize)
@@ -368,7 +360,7 @@ void CCallback::buildBoat( const IShipyard *obj )
 }
 
 CCallback::CCallback(CGameState * GS, std::optional<PlayerColor> Player, CClient * C)
-	: CBattleCallback(Player, C)
+	: CClientBattleCallback(Player, C)
 {
 	gs = GS;
 
@@ -391,7 +383,7 @@ std::shared_ptr<const CPathsInfo> CCallback::getPathsInfo(const CGHeroInstance *
 
 std::optional<PlayerColor> CCallback::getPlayerID() const
 {
-	return CBattleCallback::getPlayerID();
+	return CClientBattleCallback::getPlayerID();
 }
 
 int3 CCallback::getGuardingCreaturePosition(int3 tile)
@@ -436,62 +428,13 @@ void CCallback::unregisterBattleInterface(std::shared_ptr<IBattleEventsReceiver>
 	cl->additionalBattleInts[*player] -= battleEvents;
 }
 
-CBattleCallback::CBattleCallback(std::optional<PlayerColor> player, CClient * C):
-	cl(C),
-	player(player)
-{
-}
-
-void CBattleCallback::battleMakeUnitAction(const BattleID & battleID, const BattleAction & action)
+CClientBattleCallback::CClientBattleCallback(std::optional<PlayerColor> player, CClient * C):
+	CBattleCallback(player),
+	cl(C)
 {
-	assert(!cl->gs->getBattle(battleID)->tacticDistance);
-	MakeAction ma;
-	ma.ba = action;
-	ma.battleID = battleID;
-	sendRequest(ma);
 }
 
-void CBattleCallback::battleMakeTacticAction(const BattleID & battleID, const BattleAction & action )
-{
-	assert(cl->gs->getBattle(battleID)->tacticDistance);
-	MakeAction ma;
-	ma.ba = action;
-	ma.battleID = battleID;
-	sendRequest(ma);
-}
-
-std::optional<BattleAction> CBattleCallback::makeSurrenderRetreatDecision(const BattleID & battleID, const BattleStateInfoForRetreat & battleState)
+std::optional<BattleAction> CClientBattleCallback::makeSurrenderRetreatDecision(const BattleID & battleID, const BattleStateInfoForRetreat & battleState)
 {
 	return cl->playerint[getPlayerID().value()]->makeSurrenderRetreatDecision(battleID, battleState);
 }
-
-std::shared_ptr<CPlayerBattleCallback> CBattleCallback::getBattle(const BattleID & battleID)
-{
-	if (activeBattles.count(battleID))
-		return activeBattles.at(battleID);
-
-	throw std::runtime_error("Failed to find battle " + std::to_string(battleID.getNum()) + " of player " + player->toString() + ". Number of ongoing battles: " + std::to_string(activeBattles.size()));
-}
-
-std::optional<PlayerColor> CBattleCallback::getPlayerID() const
-{
-	return player;
-}
-
-void CBattleCallback::onBattleStarted(const IBattleInfo * info)
-{
-	if (activeBattles.count(info->getBattleID()) > 0)
-		throw std::runtime_error("Player " + player->toString() + " is already engaged in battle " + std::to_string(info->getBattleID().getNum()));
-
-	logGlobal->debug("Battle %d started for player %s", info->getBattleID(), player->toString());
-	activeBattles[info->getBattleID()] = std::make_shared<CPlayerBattleCallback>(info, *getPlayerID());
-}
-
-void CBattleCallback::onBattleEnded(const BattleID & battleID)
-{
-	if (activeBattles.count(battleID) == 0)
-		throw std::runtime_error("Player " + player->toString() + " is not engaged in battle " + std::to_string(battleID.getNum()));
-
-	logGlobal->debug("Battle %d ended for player %s", battleID, player->toString());
-	activeBattles.erase(battleID);
-}
@@ -10,6 +10,7 @@
 #pragma once
 
 #include "lib/CGameInfoCallback.h"
+#include "lib/battle/CBattleCallback.h"
 #include "lib/battle/CPlayerBattleCallback.h"
 #include "lib/int3.h" // for int3
 #include "lib/networkPacks/TradeItem.h"
@@ -45,23 +46,6 @@ VCMI_LIB_USING_NAMESPACE
 class CClient;
 struct lua_State;
 
-class IBattleCallback
-{
-public:
-	virtual ~IBattleCallback() = default;
-
-	bool waitTillRealize = false; //if true, request functions will return after they are realized by server
-	bool unlockGsWhenWaiting = false;//if true after sending each request, gs mutex will be unlocked so the changes can be applied; NOTICE caller must have gs mx locked prior to any call to actiob callback!
-	//battle
-	virtual void battleMakeSpellAction(const BattleID & battleID, const BattleAction & action) = 0;
-	virtual void battleMakeUnitAction(const BattleID & battleID, const BattleAction & action) = 0;
-	virtual void battleMakeTacticAction(const BattleID & battleID, const BattleAction & action) = 0;
-	virtual std::optional<BattleAction> makeSurrenderRetreatDecision(const BattleID & battleID, const BattleStateInfoForRetreat & battleState) = 0;
-
-	virtual std::shared_ptr<CPlayerBattleCallback> getBattle(const BattleID & battleID) = 0;
-	virtual std::optional<PlayerColor> getPlayerID() const = 0;
-};
-
 class IGameActionCallback
 {
 public:
@@ -121,34 +105,21 @@ public:
 	virtual void bulkMoveArtifacts(ObjectInstanceID srcHero, ObjectInstanceID dstHero, bool swap, bool equipped, bool backpack) = 0;
 };
 
-class CBattleCallback : public IBattleCallback
+class CClientBattleCallback : public CBattleCallback
 {
-	std::map<BattleID, std::shared_ptr<CPlayerBattleCallback>> activeBattles;
-
-	std::optional<PlayerColor> player;
-
 protected:
-	int sendRequest(const CPackForServer & request); //returns requestID (that'll be matched to requestID in PackageApplied)
+	int sendRequest(const CPackForServer & request) override;
 	CClient *cl;
 
 public:
-	CBattleCallback(std::optional<PlayerColor> player, CClient * C);
-	void battleMakeSpellAction(const BattleID & battleID, const BattleAction & action) override;//for casting spells by hero - DO NOT use it for moving active stack
-	void battleMakeUnitAction(const BattleID & battleID, const BattleAction & action) override;
-	void battleMakeTacticAction(const BattleID & battleID, const BattleAction & action) override; // performs tactic phase actions
+	CClientBattleCallback(std::optional<PlayerColor> player, CClient * C);
 	std::optional<BattleAction> makeSurrenderRetreatDecision(const BattleID & battleID, const BattleStateInfoForRetreat & battleState) override;
 
-	std::shared_ptr<CPlayerBattleCallback> getBattle(const BattleID & battleID) override;
-	std::optional<PlayerColor> getPlayerID() const override;
-
-	void onBattleStarted(const IBattleInfo * info);
-	void onBattleEnded(const BattleID & battleID);
-
 	friend class CCallback;
 	friend class CClient;
 };
 
-class CCallback : public CPlayerSpecificInfoCallback, public CBattleCallback, public IGameActionCallback
+class CCallback : public CPlayerSpecificInfoCallback, public CClientBattleCallback, public IGameActionCallback
 {
 public:
 	CCallback(CGameState * GS, std::optional<PlayerColor> Player, CClient * C);
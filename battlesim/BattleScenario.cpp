@@ -0,0 +1,212 @@
+/*
+ * BattleScenario.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#include "StdInc.h"
+#include "BattleScenario.h"
+
+#include "../lib/TerrainHandler.h"
+#include "../lib/VCMI_Lib.h"
+#include "../lib/entities/hero/CHero.h"
+#include "../lib/entities/hero/CHeroClass.h"
+#include "../lib/filesystem/CMemoryBuffer.h"
+#include "../lib/filesystem/CZipSaver.h"
+#include "../lib/mapObjectConstructors/AObjectTypeHandler.h"
+#include "../lib/mapObjectConstructors/CObjectClassesHandler.h"
+#include "../lib/mapObjects/ObjectTemplate.h"
+#include "../lib/mapping/CMap.h"
+#include "../lib/mapping/MapFormatJson.h"
+#include "../lib/modding/ModScope.h"
+
+const int BattleScenario::MAP_SIZE = 16;
+
+const PlayerColor BattleScenario::ATTACKER = PlayerColor(0);
+const PlayerColor BattleScenario::DEFENDER = PlayerColor(1);
+
+BattleScenario::BattleScenario(const JsonNode & config)
+	: terrain(ETerrainId::GRASS)
+	, battlefield(BattleField::NONE)
+	, obstacles(true)
+	, siege(false)
+{
+	if(!config["terrain"].isNull())
+		terrain = TerrainId(TerrainId::decode(config["terrain"].String()));
+
+	if(!config["battlefield"].isNull())
+		battlefield = BattleField(BattleField::decode(config["battlefield"].String()));
+
+	if(!config["obstacles"].isNull())
+		obstacles = config["obstacles"].Bool();
+
+	if(config["attacker"].isNull() || config["defender"].isNull())
+		throw std::runtime_error("Battle scenario must have both attacker and defender hero");
+
+	const TerrainType * terrainType = terrain.toEntity(VLC);
+
+	if(!terrainType->isLand() || !terrainType->isPassable())
+		throw std::runtime_error("Battle scenario terrain must be passable land");
+
+	const int3 attackerPos(MAP_SIZE / 2 - 3, MAP_SIZE / 2, 0);
+	const int3 defenderPos(MAP_SIZE / 2 + 2, MAP_SIZE / 2, 0);
+
+	objects["hero_0"] = makeHero(config["attacker"], ATTACKER, attackerPos);
+	objects["hero_1"] = makeHero(config["defender"], DEFENDER, defenderPos);
+
+	// defender stands at the town gate so game state makes him visiting hero of that town
+	if(!config["town"].isNull())
+	{
+		objects["town_0"] = makeTown(config["town"], DEFENDER, defenderPos);
+		siege = true;
+	}
+
+	header["versionMajor"].Integer() = CMapFormatJson::VERSION_MAJOR;
+	header["versionMinor"].Integer() = CMapFormatJson::VERSION_MINOR;
+	header["name"].String() = "Battle simulator scenario";
+	header["difficulty"].String() = "NORMAL";
+
+	auto & levels = header["mapLevels"]["surface"];
+	levels["width"].Integer() = MAP_SIZE;
+	levels["height"].Integer() = MAP_SIZE;
+	levels["index"].Integer() = 0;
+
+	for(const auto & color : {ATTACKER, DEFENDER})
+		header["players"][color.toString()]["canPlay"].String() = "AIOnly";
+
+	const std::string tileCode = terrainType->shortIdentifier + "0_";
+
+	for(int y = 0; y < MAP_SIZE; ++y)
+	{
+		JsonNode row;
+		for(int x = 0; x < MAP_SIZE; ++x)
+			row.Vector().emplace_back(tileCode);
+		surface.Vector().push_back(row);
+	}
+}
+
+JsonNode BattleScenario::makeObject(const std::string & type, const std::string & subtype, const JsonNode & options, const int3 & visitablePos) const
+{
+	auto handler = VLC->objtypeh->getHandlerFor(ModScope::scopeMap(), type, subtype);
+
+	auto templates = handler->getTemplates(terrain);
+	if(templates.empty())
+		templates = handler->getTemplates();
+	if(templates.empty())
+		throw std::runtime_error("No appearance for object " + type + "::" + subtype);
+
+	const auto & appearance = templates.front();
+	const int3 pos = visitablePos + appearance->getVisitableOffset();
+
+	JsonNode result;
+	result["type"].String() = handler->getTypeName();
+	result["subtype"].String() = handler->getSubTypeName();
+	result["x"].Integer() = pos.x;
+	result["y"].Integer() = pos.y;
+	result["l"].Integer() = pos.z;
+	appearance->writeJson(result["template"], false);
+	result["options"] = options;
+	return result;
+}
+
+JsonNode BattleScenario::makeHero(const JsonNode & config, const PlayerColor & owner, const int3 & visitablePos) const
+{
+	HeroTypeID heroType(HeroTypeID::decode(config["type"].String()));
+	if(heroType.getNum() < 0)
+		throw std::runtime_error("Battle scenario hero must have specific type");
+
+	JsonNode options = config;
+	options["owner"].String() = owner.toString();
+
+	auto handler = VLC->objtypeh->getHandlerFor(Obj::HERO, heroType.toHeroType()->heroClass->getIndex());
+	return makeObject(handler->getTypeName(), handler->getSubTypeName(), options, visitablePos);
+}
+
+JsonNode BattleScenario::makeTown(const JsonNode & config, const PlayerColor & owner, const int3 & visitablePos) const
+{
+	JsonNode options = config;
+	options.Struct().erase("faction");
+	options["owner"].String() = owner.toString();
+
+	// town without any walls is still attacked, but that is not a siege
+	if(options["buildings"].isNull() && options["hasFort"].isNull())
+		options["hasFort"].Bool() = true;
+
+	return makeObject("town", config["faction"].String(), options, visitablePos);
+}
+
+TerrainId BattleScenario::getTerrain() const
+{
+	return terrain;
+}
+
+BattleField BattleScenario::getBattlefield() const
+{
+	return battlefield;
+}
+
+bool BattleScenario::obstaclesAllowed() const
+{
+	return obstacles;
+}
+
+bool BattleScenario::isSiege() const
+{
+	return siege;
+}
+
+void BattleScenario::writeArchive(CMemoryBuffer & buffer) const
+{
+	{
+		std::shared_ptr<CIOApi> io(new CProxyIOApi(&buffer));
+		CZipSaver saver(io, "_");
+
+		addToArchive(saver, header, CMapFormatJson::HEADER_FILE_NAME);
+		addToArchive(saver, objects, CMapFormatJson::OBJECTS_FILE_NAME);
+		addToArchive(saver, surface, CMapFormatJson::TERRAIN_FILE_NAMES[0]);
+	}
+	buffer.seek(0);
+}
+
+void BattleScenario::addToArchive(CZipSaver & saver, const JsonNode & data, const std::string & filename)
+{
+	auto s = data.toString();
+	std::unique_ptr<COutputStream> stream = saver.addFile(filename);
+
+	if(stream->write(reinterpret_cast<const ui8 *>(s.c_str()), s.size()) != s.size())
+		throw std::runtime_error("addToArchive: zip compression failed.");
+}
+
+std::unique_ptr<CMap> BattleScenario::loadMap(const ResourcePath & name, IGameCallback * cb) const
+{
+	CMemoryBuffer buffer;
+	writeArchive(buffer);
+	CMapLoaderJson loader(&buffer);
+	return loader.loadMap(cb);
+}
+
+std::unique_ptr<CMapHeader> BattleScenario::loadMapHeader(const ResourcePath & name) const
+{
+	CMemoryBuffer buffer;
+	writeArchive(buffer);
+	CMapLoaderJson loader(&buffer);
+	return loader.loadMapHeader();
+}
+
+std::unique_ptr<CMap> BattleScenario::loadMap(const uint8_t * buffer, int size, const std::string & name, const std::string & modName, const std::string & encoding, IGameCallback * cb) const
+{
+	throw std::runtime_error("Battle scenario can not be loaded from map file");
+}
+
+std::unique_ptr<CMapHeader> BattleScenario::loadMapHeader(const uint8_t * buffer, int size, const std::string & name, const std::string & modName, const std::string & encoding) const
+{
+	throw std::runtime_error("Battle scenario can not be loaded from map file");
+}
+
+void BattleScenario::saveMap(const std::unique_ptr<CMap> & map, boost::filesystem::path fullPath) const
+{
+	throw std::runtime_error("Battle scenario can not be saved");
+}
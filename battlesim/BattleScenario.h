@@ -0,0 +1,63 @@
+/*
+ * BattleScenario.h, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#pragma once
+
+#include "../lib/constants/EntityIdentifiers.h"
+#include "../lib/int3.h"
+#include "../lib/json/JsonNode.h"
+#include "../lib/mapping/CMapService.h"
+
+VCMI_LIB_NAMESPACE_BEGIN
+
+class CMemoryBuffer;
+class CZipSaver;
+
+VCMI_LIB_NAMESPACE_END
+
+/// Setup of a single battle for simulator: two heroes with their armies, terrain and optional town to siege
+/// Scenario is turned into a small map in json format so game state is created exactly as for any other map
+class BattleScenario final : public IMapService
+{
+	static const int MAP_SIZE;
+
+	TerrainId terrain;
+	BattleField battlefield;
+	bool obstacles;
+	bool siege;
+
+	JsonNode header;
+	JsonNode objects;
+	JsonNode surface;
+
+	JsonNode makeObject(const std::string & type, const std::string & subtype, const JsonNode & options, const int3 & visitablePos) const;
+	JsonNode makeHero(const JsonNode & config, const PlayerColor & owner, const int3 & visitablePos) const;
+	JsonNode makeTown(const JsonNode & config, const PlayerColor & owner, const int3 & visitablePos) const;
+
+	void writeArchive(CMemoryBuffer & buffer) const;
+	static void addToArchive(CZipSaver & saver, const JsonNode & data, const std::string & filename);
+
+public:
+	static const PlayerColor ATTACKER;
+	static const PlayerColor DEFENDER;
+
+	explicit BattleScenario(const JsonNode & config);
+
+	TerrainId getTerrain() const;
+	/// BattleField::NONE if battlefield should be selected by map rules, same as on adventure map
+	BattleField getBattlefield() const;
+	bool obstaclesAllowed() const;
+	bool isSiege() const;
+
+	std::unique_ptr<CMap> loadMap(const ResourcePath & name, IGameCallback * cb) const override;
+	std::unique_ptr<CMapHeader> loadMapHeader(const ResourcePath & name) const override;
+	std::unique_ptr<CMap> loadMap(const uint8_t * buffer, int size, const std::string & name, const std::string & modName, const std::string & encoding, IGameCallback * cb) const override;
+	std::unique_ptr<CMapHeader> loadMapHeader(const uint8_t * buffer, int size, const std::string & name, const std::string & modName, const std::string & encoding) const override;
+	void saveMap(const std::unique_ptr<CMap> & map, boost::filesystem::path fullPath) const override;
+};
@@ -0,0 +1,313 @@
+/*
+ * BattleSimulator.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#include "StdInc.h"
+#include "BattleSimulator.h"
+
+#include "BattleScenario.h"
+
+#include "../server/CGameHandler.h"
+#include "../server/battles/BattleProcessor.h"
+
+#include "../lib/CGameInterface.h"
+#include "../lib/CPlayerState.h"
+#include "../lib/CRandomGenerator.h"
+#include "../lib/CStack.h"
+#include "../lib/LoadProgress.h"
+#include "../lib/battle/BattleInfo.h"
+#include "../lib/battle/BattleLayout.h"
+#include "../lib/battle/CBattleCallback.h"
+#include "../lib/gameState/CGameState.h"
+#include "../lib/mapObjects/CGHeroInstance.h"
+#include "../lib/mapObjects/CGTownInstance.h"
+#include "../lib/mapping/CMapHeader.h"
+#include "../lib/networkPacks/PacksForServer.h"
+#include "../lib/rmg/threadpool/ThreadPool.h"
+
+/// Battle callback that collects actions of battle AI instead of sending them to server
+class SimulatorBattleCallback final : public CBattleCallback
+{
+	std::vector<BattleAction> requestedActions;
+
+protected:
+	int sendRequest(const CPackForServer & request) override
+	{
+		const auto * makeAction = dynamic_cast<const MakeAction *>(&request);
+
+		if(!makeAction)
+			throw std::runtime_error("Battle AI has sent unexpected request to battle simulator");
+
+		requestedActions.push_back(makeAction->ba);
+		return static_cast<int>(requestedActions.size());
+	}
+
+public:
+	using CBattleCallback::CBattleCallback;
+
+	std::optional<BattleAction> makeSurrenderRetreatDecision(const BattleID & battleID, const BattleStateInfoForRetreat & battleState) override
+	{
+		return std::nullopt;
+	}
+
+	std::vector<BattleAction> takeRequestedActions()
+	{
+		return std::exchange(requestedActions, {});
+	}
+};
+
+BattleSimulator::BattleSimulator(const BattleScenario & scenario, const BattleSimulatorOptions & options)
+	: scenario(scenario)
+	, options(options)
+{
+	startInfo.mapname = "battlesim";
+	startInfo.difficulty = options.difficulty;
+	startInfo.mode = EStartMode::NEW_GAME;
+
+	std::unique_ptr<CMapHeader> header = scenario.loadMapHeader(ResourcePath(startInfo.mapname));
+
+	for(int i = 0; i < header->players.size(); i++)
+	{
+		const PlayerInfo & pinfo = header->players[i];
+
+		if(!pinfo.canComputerPlay)
+			continue;
+
+		// no connected players - both sides are controlled by AI
+		PlayerSettings & pset = startInfo.playerInfos[PlayerColor(i)];
+		pset.color = PlayerColor(i);
+		pset.name = pset.color.toString();
+		pset.castle = pinfo.defaultCastle();
+		pset.hero = pinfo.defaultHero();
+	}
+}
+
+void BattleSimulator::run()
+{
+	auto start = std::chrono::steady_clock::now();
+
+	if(options.threads <= 1)
+	{
+		for(int i = 0; i < options.battles; i++)
+			runBattle(i);
+	}
+	else
+	{
+		ThreadPool pool;
+		std::vector<boost::future<void>> futures;
+
+		pool.init(options.threads);
+
+		for(int i = 0; i < options.battles; i++)
+			futures.push_back(pool.async([this, i](){ runBattle(i); }));
+
+		for(auto & future : futures)
+			future.get();
+	}
+
+	stats.elapsedSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+void BattleSimulator::runBattle(int index)
+{
+	try
+	{
+		simulateBattle(index);
+	}
+	catch(const std::exception & e)
+	{
+		logGlobal->error("Battle %d has failed: %s", index, e.what());
+
+		boost::lock_guard<boost::mutex> lock(statsMutex);
+		stats.failed++;
+	}
+}
+
+void BattleSimulator::simulateBattle(int index)
+{
+	StartInfo si = startInfo;
+	Load::ProgressAccumulator progressTracking;
+
+	std::shared_ptr<CGameHandler> gh;
+	BattleSideArray<std::shared_ptr<CBattleGameInterface>> ais;
+	BattleSideArray<std::shared_ptr<SimulatorBattleCallback>> callbacks;
+	BattleSideArray<ObjectInstanceID> heroes;
+	BattleID battleID;
+
+	{
+		boost::lock_guard<boost::mutex> lock(gameStateMutex);
+
+		gh = std::make_shared<CGameHandler>(nullptr);
+		gh->init(&si, progressTracking, scenario);
+
+		if(options.seed != 0)
+			gh->randomNumberGenerator->setSeed(options.seed + index);
+
+		CGameState * gs = gh->gameState();
+		const CGHeroInstance * attacker = gs->getPlayerState(BattleScenario::ATTACKER)->getHeroes().at(0);
+		const CGHeroInstance * defender = gs->getPlayerState(BattleScenario::DEFENDER)->getHeroes().at(0);
+		const CGTownInstance * town = scenario.isSiege() ? defender->visitedTown.get() : nullptr;
+		const int3 tile = defender->visitablePos();
+
+		BattleField battlefield = scenario.getBattlefield();
+		if(battlefield == BattleField::NONE)
+			battlefield = gs->battleGetBattlefieldType(tile, gh->getRandomGenerator());
+
+		BattleLayout layout = BattleLayout::createDefaultLayout(gh.get(), attacker, defender);
+		layout.obstaclesAllowed = scenario.obstaclesAllowed();
+
+		gh->battles->startBattle(attacker, defender, tile, scenario.getTerrain(), battlefield, attacker, defender, layout, town);
+
+		const BattleInfo * battle = gs->getBattle(BattleScenario::ATTACKER);
+		battleID = battle->getBattleID();
+		heroes[BattleSide::ATTACKER] = attacker->id;
+		heroes[BattleSide::DEFENDER] = defender->id;
+
+		// game handler itself is the environment, AI will keep it alive while it exists
+		std::shared_ptr<Environment> environment(gh, static_cast<Environment *>(gh.get()));
+
+		for(auto side : {BattleSide::ATTACKER, BattleSide::DEFENDER})
+		{
+			PlayerColor color = battle->getSidePlayer(side);
+
+			callbacks[side] = std::make_shared<SimulatorBattleCallback>(color);
+			callbacks[side]->onBattleStarted(battle);
+
+			ais[side] = CDynLibHandler::getNewBattleAI(side == BattleSide::ATTACKER ? options.attackerAI : options.defenderAI);
+			ais[side]->playerID = color;
+			ais[side]->initBattleInterface(environment, callbacks[side]);
+			ais[side]->battleStart(battleID, attacker, defender, tile, attacker, defender, side, false);
+		}
+	}
+
+	std::vector<int64_t> latencies;
+	int64_t actions = 0;
+	int64_t rejectedActions = 0;
+
+	while(actions < options.maxActions)
+	{
+		const BattleInfo * battle = gh->gameState()->getBattle(battleID);
+
+		if(!battle || battle->battleIsFinished())
+			break;
+
+		BattleSide side;
+		BattleAction fallback;
+		auto decisionStart = std::chrono::steady_clock::now();
+
+		if(battle->battleGetTacticDist())
+		{
+			side = battle->battleGetTacticsSide();
+			ais[side]->yourTacticPhase(battleID, battle->battleGetTacticDist());
+			fallback = BattleAction::makeEndOFTacticPhase(side);
+		}
+		else
+		{
+			const CStack * stack = battle->battleGetStackByID(battle->getActiveStackID());
+
+			if(!stack)
+				break;
+
+			side = stack->unitSide();
+			ais[side]->activeStack(battleID, stack);
+			fallback = BattleAction::makeDefend(stack);
+		}
+
+		auto decisionTime = std::chrono::steady_clock::now() - decisionStart;
+		latencies.push_back(std::chrono::duration_cast<std::chrono::microseconds>(decisionTime).count());
+
+		// AI that has not made any action would hang real game, treat it as defending unit
+		std::vector<BattleAction> requested = callbacks[side]->takeRequestedActions();
+		if(requested.empty())
+			requested.push_back(fallback);
+
+		PlayerColor player = battle->getSidePlayer(side);
+
+		for(const auto & action : requested)
+		{
+			actions++;
+
+			if(!gh->battles->makePlayerBattleAction(battleID, player, action))
+				rejectedActions++;
+
+			// battle may have ended and been removed from game state
+			if(!gh->gameState()->getBattle(battleID))
+				break;
+		}
+	}
+
+	// finished battle is usually removed from game state right away, losing hero together with it
+	std::optional<BattleSide> winner;
+	if(const auto * battle = gh->gameState()->getBattle(battleID))
+	{
+		winner = battle->battleIsFinished();
+	}
+	else
+	{
+		bool attackerAlive = gh->getHero(heroes[BattleSide::ATTACKER]) != nullptr;
+		bool defenderAlive = gh->getHero(heroes[BattleSide::DEFENDER]) != nullptr;
+
+		if(attackerAlive != defenderAlive)
+			winner = attackerAlive ? BattleSide::ATTACKER : BattleSide::DEFENDER;
+		else if(!attackerAlive)
+			winner = BattleSide::NONE;
+	}
+
+	{
+		boost::lock_guard<boost::mutex> lock(gameStateMutex);
+
+		for(auto side : {BattleSide::ATTACKER, BattleSide::DEFENDER})
+		{
+			ais[side].reset();
+			callbacks[side].reset();
+		}
+		gh.reset();
+	}
+
+	boost::lock_guard<boost::mutex> lock(statsMutex);
+
+	if(!winner)
+		stats.unfinished++;
+	else if(*winner == BattleSide::ATTACKER)
+		stats.attackerWins++;
+	else if(*winner == BattleSide::DEFENDER)
+		stats.defenderWins++;
+	else
+		stats.draws++;
+
+	stats.actions += actions;
+	stats.rejectedActions += rejectedActions;
+	vstd::concatenate(stats.decisionLatencies, latencies);
+}
+
+void BattleSimulator::report(std::ostream & out) const
+{
+	auto percentile = [](const std::vector<int64_t> & sorted, double fraction) -> int64_t
+	{
+		if(sorted.empty())
+			return 0;
+
+		auto rank = static_cast<size_t>(std::ceil(fraction * sorted.size()));
+		return sorted.at(std::clamp<size_t>(rank, 1, sorted.size()) - 1);
+	};
+
+	std::vector<int64_t> latencies = stats.decisionLatencies;
+	std::sort(latencies.begin(), latencies.end());
+
+	double battlesPerSecond = stats.elapsedSeconds > 0 ? options.battles / stats.elapsedSeconds : 0;
+
+	out << boost::format("Battles: %d on %d threads in %.2f s, %.2f battles/s\n") % options.battles % std::max(1, options.threads) % stats.elapsedSeconds % battlesPerSecond;
+	out << boost::format("Attacker wins: %d, defender wins: %d, draws: %d, unfinished: %d, failed: %d\n") % stats.attackerWins % stats.defenderWins % stats.draws % stats.unfinished % stats.failed;
+	out << boost::format("Actions: %d, rejected: %d\n") % stats.actions % stats.rejectedActions;
+	out << boost::format("Decision latency over %d decisions (us): p50 %d, p90 %d, p99 %d, max %d\n")
+		% latencies.size()
+		% percentile(latencies, 0.5)
+		% percentile(latencies, 0.9)
+		% percentile(latencies, 0.99)
+		% (latencies.empty() ? 0 : latencies.back());
+}
@@ -0,0 +1,61 @@
+/*
+ * BattleSimulator.h, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#pragma once
+
+#include "../lib/StartInfo.h"
+
+class BattleScenario;
+
+struct BattleSimulatorOptions
+{
+	std::string attackerAI = "BattleAI";
+	std::string defenderAI = "BattleAI";
+	int battles = 1;
+	int threads = 1;
+	int seed = 0; // 0 - use random seed for each battle
+	int maxActions = 2000; // battle that needs more actions is considered unfinished
+	int difficulty = 1;
+};
+
+struct BattleSimulatorStats
+{
+	int attackerWins = 0;
+	int defenderWins = 0;
+	int draws = 0;
+	int unfinished = 0;
+	int failed = 0;
+	int64_t actions = 0;
+	int64_t rejectedActions = 0;
+	std::vector<int64_t> decisionLatencies; // in microseconds, one entry per call to battle AI
+	double elapsedSeconds = 0;
+};
+
+/// Runs battles of a single scenario between two battle AIs without any clients or network
+/// Every battle gets its own game handler, so battles are independent and can be run in parallel
+class BattleSimulator
+{
+	const BattleScenario & scenario;
+	const BattleSimulatorOptions & options;
+	StartInfo startInfo;
+
+	/// game state setup and destruction are not proven to be safe in parallel, so they are serialized
+	boost::mutex gameStateMutex;
+	boost::mutex statsMutex;
+	BattleSimulatorStats stats;
+
+	void runBattle(int index);
+	void simulateBattle(int index);
+
+public:
+	BattleSimulator(const BattleScenario & scenario, const BattleSimulatorOptions & options);
+
+	void run();
+	void report(std::ostream & out) const;
+};
@@ -0,0 +1,134 @@
+/*
+ * EntryPoint.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#include "StdInc.h"
+
+#include "BattleScenario.h"
+#include "BattleSimulator.h"
+
+#include "../lib/CConsoleHandler.h"
+#include "../lib/logging/CBasicLogConfigurator.h"
+#include "../lib/VCMIDirs.h"
+#include "../lib/VCMI_Lib.h"
+
+#include <boost/program_options.hpp>
+
+static void handleCommandOptions(int argc, const char * argv[], boost::program_options::variables_map & options)
+{
+	boost::program_options::options_description opts("Allowed options");
+	opts.add_options()
+	("help,h", "display help and exit")
+	("version,v", "display version information and exit")
+	("scenario", boost::program_options::value<std::string>(), "path to json file with battle scenario")
+	("battles", boost::program_options::value<int>()->default_value(1), "number of battles to simulate")
+	("threads", boost::program_options::value<int>()->default_value(1), "number of battles to simulate in parallel")
+	("attacker-ai", boost::program_options::value<std::string>()->default_value("BattleAI"), "battle AI of attacking side")
+	("defender-ai", boost::program_options::value<std::string>()->default_value("BattleAI"), "battle AI of defending side")
+	("seed", boost::program_options::value<int>()->default_value(0), "seed of first battle, following battles use next seeds; 0 for random")
+	("max-actions", boost::program_options::value<int>()->default_value(2000), "number of actions after which battle is considered unfinished")
+	("difficulty", boost::program_options::value<int>()->default_value(1), "game difficulty seen by battle AI, 0-4");
+
+	if(argc > 1)
+	{
+		try
+		{
+			boost::program_options::store(boost::program_options::parse_command_line(argc, argv, opts), options);
+		}
+		catch(boost::program_options::error & e)
+		{
+			std::cerr << "Failure during parsing command-line options:\n" << e.what() << std::endl;
+		}
+	}
+
+	boost::program_options::notify(options);
+
+	if(options.count("help"))
+	{
+		printf("%s - headless battle simulator\n", GameConstants::VCMI_VERSION.c_str());
+		printf("\n");
+		std::cout << opts;
+		exit(0);
+	}
+
+	if(options.count("version"))
+	{
+		printf("%s\n", GameConstants::VCMI_VERSION.c_str());
+		std::cout << VCMIDirs::get().genHelpString();
+		exit(0);
+	}
+
+	if(!options.count("scenario"))
+	{
+		std::cerr << "Battle scenario is required\n" << opts;
+		exit(1);
+	}
+}
+
+static JsonNode loadScenario(const boost::filesystem::path & path)
+{
+	std::ifstream file(path.string(), std::ios::binary);
+	if(!file)
+		throw std::runtime_error("Failed to open battle scenario " + path.string());
+
+	std::string data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+	return JsonNode(reinterpret_cast<const std::byte *>(data.data()), data.size(), path.string());
+}
+
+int main(int argc, const char * argv[])
+{
+	boost::program_options::variables_map opts;
+	handleCommandOptions(argc, argv, opts);
+
+	// scenario path is relative to directory simulator was started from
+	const boost::filesystem::path scenarioPath = boost::filesystem::absolute(opts["scenario"].as<std::string>());
+
+	// Correct working dir executable folder (not bundle folder) so we can use executable relative paths
+	boost::filesystem::current_path(boost::filesystem::system_complete(argv[0]).parent_path());
+
+	console = new CConsoleHandler();
+	CBasicLogConfigurator logConfig(VCMIDirs::get().userLogsPath() / "VCMI_BattleSim_log.txt", console);
+	logConfig.configureDefault();
+
+	preinitDLL(console, false);
+	logConfig.configure();
+
+	loadDLLClasses();
+
+	int result = 0;
+
+	try
+	{
+		BattleSimulatorOptions options;
+		options.battles = opts["battles"].as<int>();
+		options.threads = opts["threads"].as<int>();
+		options.attackerAI = opts["attacker-ai"].as<std::string>();
+		options.defenderAI = opts["defender-ai"].as<std::string>();
+		options.seed = opts["seed"].as<int>();
+		options.maxActions = opts["max-actions"].as<int>();
+		options.difficulty = opts["difficulty"].as<int>();
+
+		BattleScenario scenario(loadScenario(scenarioPath));
+		BattleSimulator simulator(scenario, options);
+
+		simulator.run();
+		simulator.report(std::cout);
+
+		// BattleSimulator destructor must be called here - before VLC cleanup
+	}
+	catch(const std::exception & e)
+	{
+		logGlobal->error("Battle simulation has failed: %s", e.what());
+		result = 1;
+	}
+
+	logConfig.deconfigure();
+	vstd::clear_pointer(VLC);
+
+	return result;
+}
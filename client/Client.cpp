@@ -342,7 +342,7 @@ void CClient::installNewBattleInterface(std::shared_ptr<CBattleGameInterface> ba
 	if(needCallback)
 	{
 		logGlobal->trace("\tInitializing the battle interface for player %s", color.toString());
-		auto cbc = std::make_shared<CBattleCallback>(color, this);
+		auto cbc = std::make_shared<CClientBattleCallback>(color, this);
 		battleCallbacks[color] = cbc;
 		battleInterface->initBattleInterface(playerEnvironments.at(color), cbc);
 	}
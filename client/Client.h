@@ -22,6 +22,7 @@ class CBattleGameInterface;
 class CGameInterface;
 class BattleAction;
 class BattleInfo;
+class CBattleCallback;
 struct BankConfig;
 
 #if SCRIPTING_ENABLED
@@ -38,8 +39,8 @@ namespace events
 
 VCMI_LIB_NAMESPACE_END
 
-class CBattleCallback;
 class CCallback;
+class CClientBattleCallback;
 class CClient;
 class CBaseForCLApply;
 
@@ -155,7 +156,7 @@ public:
 	std::shared_ptr<const CPathsInfo> getPathsInfo(const CGHeroInstance * h);
 
 	friend class CCallback; //handling players actions
-	friend class CBattleCallback; //handling players actions
+	friend class CClientBattleCallback; //handling players actions
 
 	void changeSpells(const CGHeroInstance * hero, bool give, const std::set<SpellID> & spells) override {};
 	void setResearchedSpells(const CGTownInstance * town, int level, const std::vector<SpellID> & spells, bool accepted) override {};
@@ -511,6 +511,11 @@ int3 CGameInfoCallback::getMapSize() const
 	return int3(gs->map->width, gs->map->height, gs->map->twoLevel ? 2 : 1);
 }
 
+uint64_t CGameInfoCallback::getGameStateID() const
+{
+	return gs->gameStateID;
+}
+
 std::vector<const CGHeroInstance *> CGameInfoCallback::getAvailableHeroes(const CGObjectInstance * townOrTavern) const
 {
 	ASSERT_IF_CALLED_WITH_PLAYER
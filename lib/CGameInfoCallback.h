@@ -202,6 +202,7 @@ public:
 	virtual bool isTileGuardedUnchecked(int3 tile) const;
 	virtual const CMapHeader * getMapHeader()const;
 	virtual int3 getMapSize() const; //returns size of map - z is 1 for one - level map and 2 for two level map
+	uint64_t getGameStateID() const; //different for every game state created in this process, e.g. after loading a game
 	virtual const TerrainTile * getTile(int3 tile, bool verbose = true) const;
 	virtual const TerrainTile * getTileUnchecked(int3 tile) const;
 	virtual std::shared_ptr<const boost::multi_array<TerrainTile*, 3>> getAllVisibleTiles() const;
@@ -14,7 +14,6 @@
 
 #include "spells/ViewSpellInt.h"
 
-class CBattleCallback;
 class CCallback;
 
 VCMI_LIB_NAMESPACE_BEGIN
@@ -23,6 +22,7 @@ using boost::logic::tribool;
 
 class Environment;
 
+class CBattleCallback;
 class ICallback;
 class CGlobalAI;
 struct Component;
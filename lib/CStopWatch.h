@@ -9,6 +9,8 @@
  */
 #pragma once
 
+#include <chrono>
+
 #if defined(__FreeBSD__) || defined(__OpenBSD__)
 	#include <sys/types.h>
 	#include <sys/time.h>
@@ -67,4 +69,25 @@ private:
 	}
 };
 
+/// Same as CStopWatch, but measures elapsed real time instead of process CPU time.
+/// Use it for work that runs on several threads, where CPU time adds up time of all of them
+class CWallStopWatch
+{
+	std::chrono::steady_clock::time_point last;
+
+public:
+	CWallStopWatch()
+		: last(std::chrono::steady_clock::now())
+	{
+	}
+
+	si64 getDiff() //get diff in milliseconds
+	{
+		auto now = std::chrono::steady_clock::now();
+		auto ret = std::chrono::duration_cast<std::chrono::milliseconds>(now - last).count();
+		last = now;
+		return ret;
+	}
+};
+
 VCMI_LIB_NAMESPACE_END
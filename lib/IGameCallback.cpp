@@ -202,7 +202,7 @@ void CPrivilegedInfoCallback::loadCommonState(CLoadFile & in)
 	in.serializer & gs;
 }
 
-void CPrivilegedInfoCallback::saveCommonState(CSaveFile & out) const
+void CPrivilegedInfoCallback::saveCommonState(CSaveSnapshot & out) const
 {
 	ActiveModsInSaveList activeMods;
 
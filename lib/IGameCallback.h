@@ -32,7 +32,7 @@ struct BattleLayout;
 class CCreatureSet;
 class CStackBasicDescriptor;
 class CGCreature;
-class CSaveFile;
+class CSaveSnapshot;
 class CLoadFile;
 class IObjectInterface;
 enum class EOpenWindowMode : uint8_t;
@@ -78,7 +78,7 @@ public:
 	void pickAllowedArtsSet(std::vector<const CArtifact *> & out, vstd::RNG & rand);
 	void getAllowedSpells(std::vector<SpellID> &out, std::optional<ui16> level = std::nullopt);
 
-	void saveCommonState(CSaveFile &out) const; //stores GS and VLC
+	void saveCommonState(CSaveSnapshot &out) const; //stores GS and VLC
 	void loadCommonState(CLoadFile &in); //loads GS and VLC
 };
 
@@ -0,0 +1,63 @@
+/*
+ * CBattleCallback.h, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#pragma once
+
+#include "../constants/EntityIdentifiers.h"
+
+VCMI_LIB_NAMESPACE_BEGIN
+
+class BattleAction;
+class BattleStateInfoForRetreat;
+class CPlayerBattleCallback;
+class IBattleInfo;
+struct CPackForServer;
+
+class DLL_LINKAGE IBattleCallback
+{
+public:
+	virtual ~IBattleCallback() = default;
+
+	bool waitTillRealize = false; //if true, request functions will return after they are realized by server
+	bool unlockGsWhenWaiting = false;//if true after sending each request, gs mutex will be unlocked so the changes can be applied; NOTICE caller must have gs mx locked prior to any call to actiob callback!
+	//battle
+	virtual void battleMakeSpellAction(const BattleID & battleID, const BattleAction & action) = 0;
+	virtual void battleMakeUnitAction(const BattleID & battleID, const BattleAction & action) = 0;
+	virtual void battleMakeTacticAction(const BattleID & battleID, const BattleAction & action) = 0;
+	virtual std::optional<BattleAction> makeSurrenderRetreatDecision(const BattleID & battleID, const BattleStateInfoForRetreat & battleState) = 0;
+
+	virtual std::shared_ptr<CPlayerBattleCallback> getBattle(const BattleID & battleID) = 0;
+	virtual std::optional<PlayerColor> getPlayerID() const = 0;
+};
+
+/// Battle callback of a single player, keeps track of battles that player is engaged in
+/// Delivery of actions to the server is left to the derived classes, e.g. client or battle simulator
+class DLL_LINKAGE CBattleCallback : public IBattleCallback
+{
+	std::map<BattleID, std::shared_ptr<CPlayerBattleCallback>> activeBattles;
+
+protected:
+	std::optional<PlayerColor> player;
+
+	virtual int sendRequest(const CPackForServer & request) = 0; //returns requestID (that'll be matched to requestID in PackageApplied)
+
+public:
+	explicit CBattleCallback(std::optional<PlayerColor> player);
+	void battleMakeSpellAction(const BattleID & battleID, const BattleAction & action) override;//for casting spells by hero - DO NOT use it for moving active stack
+	void battleMakeUnitAction(const BattleID & battleID, const BattleAction & action) override;
+	void battleMakeTacticAction(const BattleID & battleID, const BattleAction & action) override; // performs tactic phase actions
+
+	std::shared_ptr<CPlayerBattleCallback> getBattle(const BattleID & battleID) override;
+	std::optional<PlayerColor> getPlayerID() const override;
+
+	void onBattleStarted(const IBattleInfo * info);
+	void onBattleEnded(const BattleID & battleID);
+};
+
+VCMI_LIB_NAMESPACE_END
@@ -1059,6 +1059,51 @@ AccessibilityInfo CBattleInfoCallback::getAccessibility(const std::vector<Battle
 	return ret;
 }
 
+namespace HexMasks
+{
+
+using TMask = std::bitset<GameConstants::BFIELD_SIZE>;
+
+struct RowMasks
+{
+	TMask evenRows;
+	TMask oddRows;
+	TMask available; //side columns are never returned as neighbours
+
+	RowMasks()
+	{
+		for(int hex = 0; hex < GameConstants::BFIELD_SIZE; hex++)
+		{
+			if(BattleHex(hex).getY() % 2)
+				oddRows.set(hex);
+			else
+				evenRows.set(hex);
+
+			if(BattleHex(hex).isAvailable())
+				available.set(hex);
+		}
+	}
+};
+
+static const RowMasks rowMasks;
+
+// same tiles as BattleHex::neighbouringTiles for all given hexes at once
+// row index is hex / BFIELD_WIDTH, odd rows are shifted left, so diagonal offsets depend on row parity
+static TMask neighbouringTiles(const TMask & hexes)
+{
+	const TMask even = hexes & rowMasks.evenRows;
+	const TMask odd = hexes & rowMasks.oddRows;
+
+	TMask result = (hexes << 1) | (hexes >> 1) | (hexes << 17) | (hexes >> 17);
+
+	result |= (even >> 16) | (even << 18);
+	result |= (odd >> 18) | (odd << 16);
+
+	return result & rowMasks.available;
+}
+
+}
+
 ReachabilityInfo CBattleInfoCallback::makeBFS(const AccessibilityInfo &accessibility, const ReachabilityInfo::Parameters & params) const
 {
 	ReachabilityInfo ret;
@@ -1075,11 +1120,74 @@ ReachabilityInfo CBattleInfoCallback::makeBFS(const AccessibilityInfo &accessibi
 	auto checkParams = params;
 	checkParams.ignoreKnownAccessible = true; //Ignore starting hexes obstacles
 
+	ret.distances[params.startPosition] = 0;
+
+	if(!params.bypassEnemyStacks)
+	{
+		// all steps cost the same, so whole frontier is expanded at once using hex masks
+		HexMasks::TMask accessibleHexes;
+		HexMasks::TMask stoppingHexes;
+		HexMasks::TMask visitedHexes;
+
+		for(int hex = 0; hex < GameConstants::BFIELD_SIZE; hex++)
+		{
+			if(accessibility.accessible(hex, params.doubleWide, params.side))
+				accessibleHexes.set(hex);
+
+			if(!obstacles.empty() && isInObstacle(hex, obstacles, checkParams))
+				stoppingHexes.set(hex);
+		}
+
+		std::vector<BattleHex> frontier = {params.startPosition};
+		std::vector<BattleHex> nextFrontier;
+
+		visitedHexes.set(params.startPosition);
+
+		for(uint32_t distance = 1; !frontier.empty(); distance++)
+		{
+			HexMasks::TMask expandedHexes;
+
+			for(BattleHex hex : frontier)
+			{
+				//walking stack can't step past the obstacles
+				if(!stoppingHexes.test(hex.hex))
+					expandedHexes.set(hex.hex);
+			}
+
+			HexMasks::TMask reachedHexes = HexMasks::neighbouringTiles(expandedHexes) & accessibleHexes & ~visitedHexes;
+
+			visitedHexes |= reachedHexes;
+			nextFrontier.clear();
+
+			// predecessors are assigned in the same order as queue-based search would do
+			for(BattleHex curHex : frontier)
+			{
+				if(!expandedHexes.test(curHex.hex))
+					continue;
+
+				for(BattleHex neighbour : BattleHex::neighbouringTilesCache[curHex.hex])
+				{
+					if(neighbour.isValid() && reachedHexes.test(neighbour.hex))
+					{
+						reachedHexes.reset(neighbour.hex);
+						nextFrontier.push_back(neighbour);
+						ret.distances[neighbour.hex] = distance;
+						ret.predecessors[neighbour.hex] = curHex;
+					}
+				}
+			}
+
+			assert(reachedHexes.none()); // hex masks and neighbouring tiles disagree?
+			std::swap(frontier, nextFrontier);
+		}
+
+		return ret;
+	}
+
 	std::queue<BattleHex> hexq; //bfs queue
 
 	//first element
 	hexq.push(params.startPosition);
-	ret.distances[params.startPosition] = 0;
 
 	std::array<bool, GameConstants::BFIELD_SIZE> accessibleCache{};
 	for(int hex = 0; hex < GameConstants::BFIELD_SIZE; hex++)
@@ -1301,9 +1409,166 @@ ReachabilityInfo CBattleInfoCallback::getReachability(const ReachabilityInfo::Pa
 	}
 }
 
+ReachabilityInfo CBattleInfoCallback::updateReachability(
+	const ReachabilityInfo & previous,
+	const std::vector<BattleHex> & vacatedHexes,
+	const std::vector<BattleHex> & occupiedHexes) const
+{
+	const auto & params = previous.params;
+	ReachabilityInfo ret = previous;
+
+	for(auto hex : vacatedHexes)
+	{
+		if(!hex.isAvailable() || vstd::contains(params.knownAccessible, hex))
+			continue;
+
+		// gate state hidden below the stack is not known here
+		if(hex == BattleHex::GATE_INNER || hex == BattleHex::GATE_OUTER)
+			return getReachability(params);
+
+		if(ret.accessibility[hex] == EAccessibility::ALIVE_STACK)
+			ret.accessibility[hex] = EAccessibility::ACCESSIBLE;
+	}
+
+	for(auto hex : occupiedHexes)
+	{
+		if(!hex.isAvailable() || vstd::contains(params.knownAccessible, hex))
+			continue;
+
+		if(ret.accessibility[hex] == EAccessibility::ACCESSIBLE || ret.accessibility[hex] == EAccessibility::GATE)
+			ret.accessibility[hex] = EAccessibility::ALIVE_STACK;
+	}
+
+	std::array<bool, GameConstants::BFIELD_SIZE> wasAccessible{};
+	std::array<bool, GameConstants::BFIELD_SIZE> accessibleCache{};
+	for(int hex = 0; hex < GameConstants::BFIELD_SIZE; hex++)
+	{
+		wasAccessible[hex] = previous.accessibility.accessible(hex, params.doubleWide, params.side);
+		accessibleCache[hex] = ret.accessibility.accessible(hex, params.doubleWide, params.side);
+	}
+
+	if(params.flying)
+	{
+		for(int hex = 0; hex < GameConstants::BFIELD_SIZE; hex++)
+		{
+			if(wasAccessible[hex] == accessibleCache[hex])
+				continue;
+
+			if(accessibleCache[hex])
+			{
+				ret.predecessors[hex] = params.startPosition;
+				ret.distances[hex] = BattleHex::getDistance(params.startPosition, hex);
+			}
+			else
+			{
+				ret.predecessors[hex] = BattleHex::INVALID;
+				ret.distances[hex] = ReachabilityInfo::INFINITE_DIST;
+			}
+		}
+
+		return ret;
+	}
+
+	if(!params.startPosition.isValid())
+		return ret;
+
+	const std::set<BattleHex> obstacles = getStoppers(params.perspective);
+	auto checkParams = params;
+	checkParams.ignoreKnownAccessible = true;
+
+	// hexes which were reached through now blocked hex may only get more distant, forget them together with their subtrees
+	std::queue<BattleHex> hexq;
+	std::vector<BattleHex> forgotten;
+
+	for(int hex = 0; hex < GameConstants::BFIELD_SIZE; hex++)
+	{
+		if(wasAccessible[hex] && !accessibleCache[hex] && hex != params.startPosition && ret.isReachable(hex))
+		{
+			hexq.push(hex);
+			ret.distances[hex] = ReachabilityInfo::INFINITE_DIST;
+			ret.predecessors[hex] = BattleHex::INVALID;
+		}
+	}
+
+	while(!hexq.empty())
+	{
+		const BattleHex curHex = hexq.front();
+		hexq.pop();
+		forgotten.push_back(curHex);
+
+		for(BattleHex neighbour : BattleHex::neighbouringTilesCache[curHex.hex])
+		{
+			if(neighbour.isValid() && ret.predecessors[neighbour.hex] == curHex)
+			{
+				hexq.push(neighbour);
+				ret.distances[neighbour.hex] = ReachabilityInfo::INFINITE_DIST;
+				ret.predecessors[neighbour.hex] = BattleHex::INVALID;
+			}
+		}
+	}
+
+	// forgotten and newly accessible hexes are reached again from their still reachable neighbours
+	for(int hex = 0; hex < GameConstants::BFIELD_SIZE; hex++)
+	{
+		if(!wasAccessible[hex] && accessibleCache[hex])
+			forgotten.push_back(hex);
+	}
+
+	for(auto hex : forgotten)
+	{
+		for(BattleHex neighbour : BattleHex::neighbouringTilesCache[hex.hex])
+		{
+			if(neighbour.isValid() && ret.isReachable(neighbour))
+				hexq.push(neighbour);
+		}
+	}
+
+	while(!hexq.empty())
+	{
+		const BattleHex curHex = hexq.front();
+		hexq.pop();
+
+		//walking stack can't step past the obstacles
+		if(isInObstacle(curHex, obstacles, checkParams))
+			continue;
+
+		const int costToNeighbour = ret.distances.at(curHex.hex) + 1;
+
+		for(BattleHex neighbour : BattleHex::neighbouringTilesCache[curHex.hex])
+		{
+			if(neighbour.isValid())
+			{
+				auto additionalCost = 0;
+
+				if(params.bypassEnemyStacks)
+				{
+					auto enemyToBypass = params.destructibleEnemyTurns.find(neighbour);
+
+					if(enemyToBypass != params.destructibleEnemyTurns.end())
+					{
+						additionalCost = enemyToBypass->second;
+					}
+				}
+
+				const int costFoundSoFar = ret.distances[neighbour.hex];
+
+				if(accessibleCache[neighbour.hex] && costToNeighbour + additionalCost < costFoundSoFar)
+				{
+					hexq.push(neighbour);
+					ret.distances[neighbour.hex] = costToNeighbour + additionalCost;
+					ret.predecessors[neighbour.hex] = curHex;
+				}
+			}
+		}
+	}
+
+	return ret;
+}
+
 ReachabilityInfo CBattleInfoCallback::getFlyingReachability(const ReachabilityInfo::Parameters &params) const
 {
 	ReachabilityInfo ret;
+	ret.params = params;
 	ret.accessibility = getAccessibility(params.knownAccessible);
 
 	for(int i = 0; i < GameConstants::BFIELD_SIZE; i++)
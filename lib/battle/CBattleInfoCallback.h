@@ -160,6 +160,9 @@ public:
 
 	ReachabilityInfo getReachability(const battle::Unit * unit) const;
 	ReachabilityInfo getReachability(const ReachabilityInfo::Parameters & params) const;
+	/// Repairs reachability computed before single unit has moved from vacatedHexes to occupiedHexes
+	/// Distances are same as from full recalculation, predecessors may differ between equally short paths
+	ReachabilityInfo updateReachability(const ReachabilityInfo & previous, const std::vector<BattleHex> & vacatedHexes, const std::vector<BattleHex> & occupiedHexes) const;
 	AccessibilityInfo getAccessibility() const;
 	AccessibilityInfo getAccessibility(const battle::Unit * stack) const; //Hexes occupied by stack will be marked as accessible.
 	AccessibilityInfo getAccessibility(const std::vector<BattleHex> & accessibleHexes) const; //given hexes will be marked as accessible
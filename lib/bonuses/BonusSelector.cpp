@@ -13,6 +13,135 @@
 
 VCMI_LIB_NAMESPACE_BEGIN
 
+bool CSelector::trySetField(BonusType Bonus::*ptr, const BonusType & value)
+{
+	if(ptr != &Bonus::type)
+		return false;
+	fields |= TYPE;
+	type = value;
+	valid = true;
+	return true;
+}
+
+bool CSelector::trySetField(BonusSubtypeID Bonus::*ptr, const BonusSubtypeID & value)
+{
+	if(ptr != &Bonus::subtype)
+		return false;
+	fields |= SUBTYPE;
+	subtype = value;
+	valid = true;
+	return true;
+}
+
+bool CSelector::trySetField(BonusSource Bonus::*ptr, const BonusSource & value)
+{
+	if(ptr != &Bonus::source)
+		return false;
+	fields |= SOURCE;
+	source = value;
+	valid = true;
+	return true;
+}
+
+bool CSelector::trySetField(BonusSourceID Bonus::*ptr, const BonusSourceID & value)
+{
+	if(ptr != &Bonus::sid)
+		return false;
+	fields |= SOURCE_ID;
+	sourceID = value;
+	valid = true;
+	return true;
+}
+
+bool CSelector::trySetField(BonusValueType Bonus::*ptr, const BonusValueType & value)
+{
+	if(ptr != &Bonus::valType)
+		return false;
+	fields |= VALUE_TYPE;
+	valueType = value;
+	valid = true;
+	return true;
+}
+
+void CSelector::mergeFields(const CSelector & other)
+{
+	auto merge = [this, &other](EFields field, auto CSelector::*member)
+	{
+		if((other.fields & field) == 0)
+			return;
+
+		if((fields & field) != 0 && !(this->*member == other.*member))
+			fields |= NOTHING;
+
+		fields |= field;
+		this->*member = other.*member;
+	};
+
+	merge(TYPE, &CSelector::type);
+	merge(SUBTYPE, &CSelector::subtype);
+	merge(SOURCE, &CSelector::source);
+	merge(SOURCE_ID, &CSelector::sourceID);
+	merge(VALUE_TYPE, &CSelector::valueType);
+	fields |= other.fields & NOTHING;
+}
+
+CSelector CSelector::matchAll()
+{
+	CSelector result;
+	result.valid = true;
+	return result;
+}
+
+CSelector CSelector::matchNone()
+{
+	CSelector result;
+	result.fields = NOTHING;
+	result.valid = true;
+	return result;
+}
+
+CSelector CSelector::And(CSelector rhs) const
+{
+	CSelector result = *this;
+	result.mergeFields(rhs);
+	result.valid = true;
+
+	if(rhs.functor)
+	{
+		if(result.functor)
+		{
+			//lambda may likely outlive "this" (it can be even a temporary) => we copy the OBJECT (not pointer)
+			result.functor = [lhs = std::move(result.functor), rhs = std::move(rhs.functor)](const Bonus *b)
+			{
+				return lhs(b) && rhs(b);
+			};
+		}
+		else
+		{
+			result.functor = std::move(rhs.functor);
+		}
+	}
+	return result;
+}
+
+CSelector CSelector::Or(CSelector rhs) const
+{
+	if(fields == NOTHING && !functor)
+		return rhs;
+
+	if(rhs.fields == NOTHING && !rhs.functor)
+		return *this;
+
+	auto thisCopy = *this;
+	return [thisCopy, rhs](const Bonus *b) { return thisCopy(b) || rhs(b); };
+}
+
+CSelector CSelector::Not() const
+{
+	auto thisCopy = *this;
+	return [thisCopy](const Bonus *b) { return !thisCopy(b); };
+}
+
 namespace Selector
 {
 	DLL_LINKAGE const CSelectFieldEqual<BonusType> & type()
@@ -96,8 +225,8 @@ namespace Selector
 				.And(valueType(valType));
 	}
 
-	DLL_LINKAGE CSelector all([](const Bonus * b){return true;});
-	DLL_LINKAGE CSelector none([](const Bonus * b){return false;});
+	DLL_LINKAGE CSelector all = CSelector::matchAll();
+	DLL_LINKAGE CSelector none = CSelector::matchNone();
 }
 
 VCMI_LIB_NAMESPACE_END
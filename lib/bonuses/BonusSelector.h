@@ -14,47 +14,97 @@
 
 VCMI_LIB_NAMESPACE_BEGIN
 
-class CSelector : std::function<bool(const Bonus*)>
+class DLL_LINKAGE CSelector
 {
 	using TBase = std::function<bool(const Bonus*)>;
+
+	/// Bonus fields that are compared directly, without calling a functor
+	enum EFields : uint8_t
+	{
+		TYPE = 1 << 0,
+		SUBTYPE = 1 << 1,
+		SOURCE = 1 << 2,
+		SOURCE_ID = 1 << 3,
+		VALUE_TYPE = 1 << 4,
+		NOTHING = 1 << 7 // conflicting conditions, selector can't match any bonus
+	};
+
+	TBase functor; //arbitrary condition, checked after all fields
+	BonusSubtypeID subtype;
+	BonusSourceID sourceID;
+	BonusType type = BonusType::NONE;
+	BonusSource source = BonusSource::OTHER;
+	BonusValueType valueType = BonusValueType::ADDITIVE_VALUE;
+	uint8_t fields = 0;
+	bool valid = false;
+
+	template<typename T>
+	bool trySetField(T Bonus::*ptr, const T & value)
+	{
+		return false;
+	}
+
+	bool trySetField(BonusType Bonus::*ptr, const BonusType & value);
+	bool trySetField(BonusSubtypeID Bonus::*ptr, const BonusSubtypeID & value);
+	bool trySetField(BonusSource Bonus::*ptr, const BonusSource & value);
+	bool trySetField(BonusSourceID Bonus::*ptr, const BonusSourceID & value);
+	bool trySetField(BonusValueType Bonus::*ptr, const BonusValueType & value);
+
+	void mergeFields(const CSelector & other);
+
+	bool matchesFields(const Bonus * b) const
+	{
+		return (fields & NOTHING) == 0
+			&& ((fields & TYPE) == 0 || b->type == type)
+			&& ((fields & SUBTYPE) == 0 || b->subtype == subtype)
+			&& ((fields & SOURCE) == 0 || b->source == source)
+			&& ((fields & SOURCE_ID) == 0 || b->sid == sourceID)
+			&& ((fields & VALUE_TYPE) == 0 || b->valType == valueType);
+	}
+
+	template<typename T>
+	friend class CSelectFieldEqual;
+
 public:
 	CSelector() = default;
 	template<typename T>
 	CSelector(const T &t,	//SFINAE trick -> include this c-tor in overload resolution only if parameter is class
 							//(includes functors, lambdas) or function. Without that VC is going mad about ambiguities.
 		typename std::enable_if_t < std::is_class_v<T> || std::is_function_v<T> > *dummy = nullptr)
-		: TBase(t)
+		: functor(t)
+		, valid(true)
 	{}
 
 	CSelector(std::nullptr_t)
 	{}
 
-	CSelector And(CSelector rhs) const
-	{
-		//lambda may likely outlive "this" (it can be even a temporary) => we copy the OBJECT (not pointer)
-		auto thisCopy = *this;
-		return [thisCopy, rhs](const Bonus *b) mutable { return thisCopy(b) && rhs(b); };
-	}
-	CSelector Or(CSelector rhs) const
-	{
-		auto thisCopy = *this;
-		return [thisCopy, rhs](const Bonus *b) mutable { return thisCopy(b) || rhs(b); };
-	}
+	/// Selector that accepts every bonus, see Selector::all
+	static CSelector matchAll();
+	/// Selector that rejects every bonus, see Selector::none
+	static CSelector matchNone();
 
-	CSelector Not() const
+	/// Returns type of bonuses this selector is restricted to, if any
+	std::optional<BonusType> requiredType() const
 	{
-		auto thisCopy = *this;
-		return [thisCopy](const Bonus *b) mutable { return !thisCopy(b); };
+		if((fields & TYPE) != 0 && (fields & NOTHING) == 0)
+			return type;
+		return std::nullopt;
 	}
 
+	CSelector And(CSelector rhs) const;
+	CSelector Or(CSelector rhs) const;
+	CSelector Not() const;
+
 	bool operator()(const Bonus *b) const
 	{
-		return TBase::operator()(b);
+		if(!matchesFields(b))
+			return false;
+		return !functor || functor(b);
 	}
 
 	operator bool() const
 	{
-		return !!static_cast<const TBase&>(*this);
+		return valid;
 	}
 };
 
@@ -71,6 +121,10 @@ public:
 
 	CSelector operator()(const T &valueToCompareAgainst) const
 	{
+		CSelector result;
+		if(result.trySetField(ptr, valueToCompareAgainst))
+			return result;
+
 		auto ptr2 = ptr; //We need a COPY because we don't want to reference this (might be outlived by lambda)
 		return [ptr2, valueToCompareAgainst](const Bonus *bonus)
 		{
@@ -18,6 +18,8 @@
 VCMI_LIB_NAMESPACE_BEGIN
 
 std::atomic<int64_t> CBonusSystemNode::treeChanged(1);
+std::atomic<int64_t> CBonusSystemNode::treeInvalidated(1);
+std::atomic<int64_t> CBonusSystemNode::bonusesRecalculated(0);
 constexpr bool CBonusSystemNode::cachingEnabled = true;
 
 std::shared_ptr<Bonus> CBonusSystemNode::getLocalBonus(const CSelector & selector)
@@ -114,21 +116,24 @@ TConstBonusListPtr CBonusSystemNode::getAllBonuses(const CSelector &selector, co
 		// Exclusive access for one thread
 		boost::lock_guard<boost::mutex> lock(sync);
 
-		// If the bonus system tree changes(state of a single node or the relations to each other) then
-		// cache all bonus objects. Selector objects doesn't matter.
-		if (cachedLast != treeChanged)
+		// If this node or any of its ancestors has changed (state of a single node or the relations to each other)
+		// then cache all bonus objects. Selector objects doesn't matter.
+		const int64_t currentVersion = getTreeVersion();
+		if (cachedLast != currentVersion)
 		{
 			BonusList allBonuses;
 			allBonuses.reserve(cachedBonuses.capacity()); //we assume we'll get about the same number of bonuses
 
 			cachedBonuses.clear();
 			cachedRequests.clear();
+			bonusesRecalculated++;
 
 			getAllBonusesRec(allBonuses, Selector::all);
 			limitBonuses(allBonuses, cachedBonuses);
 			cachedBonuses.stackBonuses();
+			indexCachedBonuses();
 
-			cachedLast = treeChanged;
+			cachedLast = currentVersion;
 		}
 
 		// If a bonus system request comes with a caching string then look up in the map if there are any
@@ -146,7 +151,7 @@ TConstBonusListPtr CBonusSystemNode::getAllBonuses(const CSelector &selector, co
 		//We still don't have the bonuses (didn't returned them from cache)
 		//Perform bonus selection
 		auto ret = std::make_shared<BonusList>();
-		cachedBonuses.getBonuses(*ret, selector, limit);
+		getCachedBonuses(*ret, selector, limit);
 
 		// Save the results in the cache
 		if(!cachingStr.empty())
@@ -160,9 +165,49 @@ TConstBonusListPtr CBonusSystemNode::getAllBonuses(const CSelector &selector, co
 	}
 }
 
+void CBonusSystemNode::indexCachedBonuses() const
+{
+	cachedBonusesByType.resize(cachedBonuses.size());
+	std::iota(cachedBonusesByType.begin(), cachedBonusesByType.end(), 0);
+	std::stable_sort(cachedBonusesByType.begin(), cachedBonusesByType.end(), [this](uint32_t lhs, uint32_t rhs)
+	{
+		return cachedBonuses[lhs]->type < cachedBonuses[rhs]->type;
+	});
+}
+
+void CBonusSystemNode::getCachedBonuses(BonusList &out, const CSelector &selector, const CSelector &limit) const
+{
+	auto requiredType = selector.requiredType();
+
+	if(!requiredType)
+	{
+		cachedBonuses.getBonuses(out, selector, limit);
+		return;
+	}
+
+	// only bonuses of single type may be selected - check only them, in their original order
+	auto first = std::lower_bound(cachedBonusesByType.begin(), cachedBonusesByType.end(), *requiredType, [this](uint32_t index, BonusType type)
+	{
+		return cachedBonuses[index]->type < type;
+	});
+	auto last = std::upper_bound(first, cachedBonusesByType.end(), *requiredType, [this](BonusType type, uint32_t index)
+	{
+		return type < cachedBonuses[index]->type;
+	});
+
+	out.reserve(std::distance(first, last));
+	for(auto it = first; it != last; ++it)
+	{
+		const auto & b = cachedBonuses[*it];
+		if(selector(b.get()) && (!limit || limit(b.get())))
+			out.push_back(b);
+	}
+}
+
 TConstBonusListPtr CBonusSystemNode::getAllBonusesWithoutCaching(const CSelector &selector, const CSelector &limit) const
 {
 	auto ret = std::make_shared<BonusList>();
+	bonusesRecalculated++;
 
 	// Get bonus results without caching enabled.
 	BonusList beforeLimiting;
@@ -181,19 +226,21 @@ std::shared_ptr<Bonus> CBonusSystemNode::getUpdatedBonus(const std::shared_ptr<B
 }
 
 CBonusSystemNode::CBonusSystemNode(bool isHypotetic):
-	bonuses(true),
-	exportedBonuses(true),
+	bonuses(this),
+	exportedBonuses(this),
 	nodeType(UNKNOWN),
 	cachedLast(0),
+	nodeChanged(0),
 	isHypotheticNode(isHypotetic)
 {
 }
 
 CBonusSystemNode::CBonusSystemNode(ENodeTypes NodeType):
-	bonuses(true),
-	exportedBonuses(true),
+	bonuses(this),
+	exportedBonuses(this),
 	nodeType(NodeType),
 	cachedLast(0),
+	nodeChanged(0),
 	isHypotheticNode(false)
 {
 }
@@ -224,7 +271,7 @@ void CBonusSystemNode::attachTo(CBonusSystemNode & parent)
 		parent.newChildAttached(*this);
 	}
 
-	CBonusSystemNode::treeHasChanged();
+	nodeHasChanged();
 }
 
 void CBonusSystemNode::attachToSource(const CBonusSystemNode & parent)
@@ -238,7 +285,7 @@ void CBonusSystemNode::attachToSource(const CBonusSystemNode & parent)
 			parent.newRedDescendant(*this);
 	}
 
-	CBonusSystemNode::treeHasChanged();
+	nodeHasChanged();
 }
 
 void CBonusSystemNode::detachFrom(CBonusSystemNode & parent)
@@ -267,7 +314,7 @@ void CBonusSystemNode::detachFrom(CBonusSystemNode & parent)
 	{
 		parent.childDetached(*this);
 	}
-	CBonusSystemNode::treeHasChanged();
+	nodeHasChanged();
 }
 
 
@@ -291,7 +338,7 @@ void CBonusSystemNode::detachFromSource(const CBonusSystemNode & parent)
 			, nodeShortInfo(), nodeType, parent.nodeShortInfo(), parent.nodeType);
 	}
 
-	CBonusSystemNode::treeHasChanged();
+	nodeHasChanged();
 }
 
 void CBonusSystemNode::removeBonusesRecursive(const CSelector & s)
@@ -327,14 +374,17 @@ void CBonusSystemNode::addNewBonus(const std::shared_ptr<Bonus>& b)
 	assert(!vstd::contains(exportedBonuses, b));
 	exportedBonuses.push_back(b);
 	exportBonus(b);
-	CBonusSystemNode::treeHasChanged();
+	nodeHasChanged();
 }
 
 void CBonusSystemNode::accumulateBonus(const std::shared_ptr<Bonus>& b)
 {
 	auto bonus = exportedBonuses.getFirst(Selector::typeSubtypeValueType(b->type, b->subtype, b->valType)); //only local bonuses are interesting
 	if(bonus)
+	{
 		bonus->val += b->val;
+		nodeHasChanged();
+	}
 	else
 		addNewBonus(std::make_shared<Bonus>(*b)); //duplicate needed, original may get destroyed
 }
@@ -346,7 +396,7 @@ void CBonusSystemNode::removeBonus(const std::shared_ptr<Bonus>& b)
 		unpropagateBonus(b);
 	else
 		bonuses -= b;
-	CBonusSystemNode::treeHasChanged();
+	nodeHasChanged();
 }
 
 void CBonusSystemNode::removeBonuses(const CSelector & selector)
@@ -396,11 +446,11 @@ void CBonusSystemNode::unpropagateBonus(const std::shared_ptr<Bonus> & b)
 		else
 			logBonus->warn("Attempt to remove #$# %s, which is not propagated to %s", b->Description(), nodeName());
 
-		bonuses.remove_if([b](const auto & bonus)
+		bonuses.remove_if([this, b](const auto & bonus)
 		{
 			if (bonus->propagationUpdater && bonus->propagationUpdater == b->propagationUpdater)
 			{
-				treeHasChanged();
+				nodeHasChanged();
 				return true;
 			}
 			return false;
@@ -482,7 +532,7 @@ void CBonusSystemNode::getRedParents(TCNodes & out) const
 	}
 }
 
-void CBonusSystemNode::getRedChildren(TNodes &out)
+void CBonusSystemNode::getRedChildren(TNodes &out) const
 {
 	for(CBonusSystemNode *pname : parentsToPropagate)
 	{
@@ -556,7 +606,7 @@ void CBonusSystemNode::exportBonus(const std::shared_ptr<Bonus> & b)
 	else
 		bonuses.push_back(b);
 
-	CBonusSystemNode::treeHasChanged();
+	nodeHasChanged();
 }
 
 void CBonusSystemNode::exportBonuses()
@@ -627,12 +677,69 @@ void CBonusSystemNode::limitBonuses(const BonusList &allBonuses, BonusList &out)
 
 void CBonusSystemNode::treeHasChanged()
 {
-	treeChanged++;
+	treeInvalidated = ++treeChanged;
+}
+
+void CBonusSystemNode::nodeHasChanged() const
+{
+	const int64_t version = ++treeChanged;
+
+	invalidateSubtree(version);
+
+	// bonuses exported by this node may have been propagated to other nodes, that must be invalidated as well
+	bool hasPropagatedBonuses = std::any_of(exportedBonuses.begin(), exportedBonuses.end(), [](const auto & b){ return b->propagator != nullptr; });
+	if(!hasPropagatedBonuses)
+		return;
+
+	TNodes redDescendants;
+	TNodes toVisit;
+	getRedChildren(toVisit);
+	while(!toVisit.empty())
+	{
+		CBonusSystemNode * node = *toVisit.begin();
+		toVisit.erase(toVisit.begin());
+
+		if(redDescendants.insert(node).second)
+			node->getRedChildren(toVisit);
+	}
+
+	for(const auto * node : redDescendants)
+		node->invalidateSubtree(version);
+}
+
+void CBonusSystemNode::invalidateSubtree(int64_t version) const
+{
+	if(nodeChanged == version)
+		return; // already visited
+
+	// source-only nodes (creatures and artifacts) do not track all nodes that inherit bonuses from them
+	if(actsAsBonusSourceOnly())
+	{
+		treeInvalidated = version;
+		return;
+	}
+
+	nodeChanged = version;
+	for(const auto * child : children)
+		child->invalidateSubtree(version);
+}
+
+int64_t CBonusSystemNode::getBonusesRecalculatedCount()
+{
+	return bonusesRecalculated;
 }
 
 int64_t CBonusSystemNode::getTreeVersion() const
 {
-	return treeChanged;
+	int64_t result = std::max<int64_t>(nodeChanged, treeInvalidated);
+
+	// hypothetic nodes are not registered as children of their parents, so they have to check parents on their own
+	if(isHypothetic())
+	{
+		for(const auto * parent : parentsToInherit)
+			vstd::amax(result, parent->getTreeVersion());
+	}
+	return result;
 }
 
 VCMI_LIB_NAMESPACE_END
@@ -43,8 +43,12 @@ private:
 
 	static const bool cachingEnabled;
 	mutable BonusList cachedBonuses;
+	mutable std::vector<uint32_t> cachedBonusesByType; // indices in cachedBonuses, ordered by bonus type
 	mutable int64_t cachedLast;
-	static std::atomic<int64_t> treeChanged;
+	mutable std::atomic<int64_t> nodeChanged; // version of last change that affected this node
+	static std::atomic<int64_t> treeChanged; // version of last change anywhere in bonus system
+	static std::atomic<int64_t> treeInvalidated; // version of last change that affected all nodes
+	static std::atomic<int64_t> bonusesRecalculated; // number of times bonuses were collected from bonus tree instead of cache
 
 	// Setting a value to cachingStr before getting any bonuses caches the result for later requests.
 	// This string needs to be unique, that's why it has to be set in the following manner:
@@ -53,16 +57,20 @@ private:
 	mutable boost::mutex sync;
 
 	void getAllBonusesRec(BonusList &out, const CSelector & selector) const;
+	void getCachedBonuses(BonusList &out, const CSelector &selector, const CSelector &limit) const;
+	void indexCachedBonuses() const;
 	TConstBonusListPtr getAllBonusesWithoutCaching(const CSelector &selector, const CSelector &limit) const;
 	std::shared_ptr<Bonus> getUpdatedBonus(const std::shared_ptr<Bonus> & b, const TUpdaterPtr & updater) const;
 	void limitBonuses(const BonusList &allBonuses, BonusList &out) const; //out will bo populed with bonuses that are not limited here
 
 	void getRedParents(TCNodes &out) const;  //retrieves list of red parent nodes (nodes bonuses propagate from)
 	void getRedAncestors(TCNodes &out) const;
-	void getRedChildren(TNodes &out);
+	void getRedChildren(TNodes &out) const;
 
 	void getAllParents(TCNodes & out) const;
 
+	void invalidateSubtree(int64_t version) const; //marks this node and all its black descendants as changed
+
 	void newChildAttached(CBonusSystemNode & child);
 	void childDetached(CBonusSystemNode & child);
 	void propagateBonus(const std::shared_ptr<Bonus> & b, const CBonusSystemNode & source);
@@ -120,10 +128,19 @@ public:
 	void setNodeType(CBonusSystemNode::ENodeTypes type);
 	const TCNodesVector & getParentNodes() const;
 
+	/// Invalidates cached bonuses of all nodes in bonus system
 	static void treeHasChanged();
 
+	/// Invalidates cached bonuses of this node and all nodes that may inherit or receive bonuses from it
+	/// Const because it only bumps cache versions, which are atomic. Safe to call while other threads read bonuses,
+	/// but not while the bonus tree itself is being modified
+	void nodeHasChanged() const;
+
 	int64_t getTreeVersion() const override;
 
+	/// Returns number of times bonuses of any node were collected from bonus tree, either on cache rebuild or on uncached request
+	static int64_t getBonusesRecalculatedCount();
+
 	virtual PlayerColor getOwner() const
 	{
 		return PlayerColor::NEUTRAL;
@@ -138,7 +138,10 @@ int CGameState::getDate(Date mode) const
 	return getDate(day, mode);
 }
 
+static std::atomic<uint64_t> nextGameStateID = 0;
+
 CGameState::CGameState()
+	: gameStateID(++nextGameStateID)
 {
 	gs = this;
 	heroesPool = std::make_unique<TavernHeroesPool>();
@@ -62,6 +62,8 @@ public:
 	std::vector<std::unique_ptr<BattleInfo>> currentBattles;
 	/// ID that can be allocated to next battle
 	BattleID nextBattleID = BattleID(0);
+	/// Unique within process, so caches can tell game states apart even if a new one reuses address of old one. Not serialized
+	const uint64_t gameStateID;
 
 	//we have here all heroes available on this map that are not hired
 	std::unique_ptr<TavernHeroesPool> heroesPool;
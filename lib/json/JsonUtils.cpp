@@ -120,6 +120,9 @@ const JsonNode & getSchemaByName(const std::string & name)
 {
 	// cached schemas to avoid loading json data multiple times
 	static std::map<std::string, JsonNode> loadedSchemas;
+	// mod data is validated from several threads at once
+	static std::mutex loadedSchemasMutex;
+	std::lock_guard<std::mutex> lock(loadedSchemasMutex);
 
 	if (vstd::contains(loadedSchemas, name))
 		return loadedSchemas[name];
@@ -27,6 +27,7 @@
 #include "../CSkillHandler.h"
 #include "CMapEditManager.h"
 #include "CMapOperation.h"
+#include "TerrainNeighbourTable.h"
 #include "../serializer/JsonSerializeFormat.h"
 
 #include <vstd/RNG.h>
@@ -752,6 +753,24 @@ void CMap::initTerrain()
 {
 	terrain.resize(boost::extents[levels()][width][height]);
 	guardingCreaturePositions.resize(boost::extents[levels()][width][height]);
+
+	TLockGuard lock(terrainNeighbourTableMutex);
+	terrainNeighbourTable.reset();
+}
+
+const TerrainNeighbourTable & CMap::getTerrainNeighbourTable() const
+{
+	TLockGuard lock(terrainNeighbourTableMutex);
+	if(!terrainNeighbourTable)
+		terrainNeighbourTable = std::make_unique<TerrainNeighbourTable>(*this);
+	return *terrainNeighbourTable;
+}
+
+void CMap::updateTerrainNeighbourTable(const std::set<int3> & tiles)
+{
+	TLockGuard lock(terrainNeighbourTableMutex);
+	if(terrainNeighbourTable)
+		terrainNeighbourTable->update(*this, tiles);
 }
 
 CMapEditManager * CMap::getEditManager()
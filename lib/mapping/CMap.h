@@ -31,6 +31,7 @@ class IModableArt;
 class IQuestObject;
 class CInputStream;
 class CMapEditManager;
+class TerrainNeighbourTable;
 class JsonSerializeFormat;
 class IGameSettings;
 class GameSettings;
@@ -90,6 +91,10 @@ public:
 	const TerrainTile & getTile(const int3 & tile) const;
 	bool isCoastalTile(const int3 & pos) const;
 	bool isWaterTile(const int3 & pos) const;
+	/// Neighbour masks for pathfinder, built on first use
+	const TerrainNeighbourTable & getTerrainNeighbourTable() const;
+	/// Must be called after terrain of map has been edited, with tiles around edited ones
+	void updateTerrainNeighbourTable(const std::set<int3> & tiles);
 	inline bool isInTheMap(const int3 & pos) const
 	{
 		// Check whether coord < 0 is done implicitly. Negative signed int overflows to unsigned number larger than all signed ints.
@@ -193,6 +198,9 @@ private:
 
 	si32 uidCounter; //TODO: initialize when loading an old map
 
+	mutable std::unique_ptr<TerrainNeighbourTable> terrainNeighbourTable;
+	mutable std::mutex terrainNeighbourTableMutex;
+
 public:
 	template <typename Handler>
 	void serialize(Handler &h)
@@ -108,6 +108,7 @@ void CDrawTerrainOperation::execute()
 	}
 
 	updateTerrainTypes();
+	map->updateTerrainNeighbourTable(invalidatedTerViews);
 	updateTerrainViews();
 }
 
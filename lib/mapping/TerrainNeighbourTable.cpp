@@ -0,0 +1,79 @@
+/*
+ * TerrainNeighbourTable.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+
+#include "StdInc.h"
+#include "TerrainNeighbourTable.h"
+
+#include "CMap.h"
+#include "../TerrainHandler.h"
+
+VCMI_LIB_NAMESPACE_BEGIN
+
+const std::array<int3, 8> TerrainNeighbourTable::dirs = {
+	int3(-1, +1, +0),	int3(0, +1, +0),	int3(+1, +1, +0),
+	int3(-1, +0, +0),	/* source pos */	int3(+1, +0, +0),
+	int3(-1, -1, +0),	int3(0, -1, +0),	int3(+1, -1, +0)
+};
+
+TerrainNeighbourTable::TerrainNeighbourTable(const CMap & map)
+	: sizes(map.width, map.height, map.levels())
+	, masks(static_cast<size_t>(sizes.x) * sizes.y * sizes.z)
+{
+	int3 pos;
+	for(pos.z = 0; pos.z < sizes.z; pos.z++)
+		for(pos.y = 0; pos.y < sizes.y; pos.y++)
+			for(pos.x = 0; pos.x < sizes.x; pos.x++)
+				updateTile(map, pos);
+}
+
+void TerrainNeighbourTable::update(const CMap & map, const std::set<int3> & tiles)
+{
+	for(const auto & tile : tiles)
+	{
+		if(map.isInTheMap(tile))
+			updateTile(map, tile);
+	}
+}
+
+void TerrainNeighbourTable::updateTile(const CMap & map, const int3 & tile)
+{
+	Masks result;
+	const bool srcWater = map.getTile(tile).terType->isWater();
+
+	for(size_t i = 0; i < dirs.size(); i++)
+	{
+		const int3 & dir = dirs[i];
+		const int3 destCoord = tile + dir;
+		if(!map.isInTheMap(destCoord))
+			continue;
+
+		const auto * destTerrain = map.getTile(destCoord).terType;
+		if(!destTerrain->isPassable())
+			continue;
+
+		const ui8 bit = 1 << i;
+		result.passable |= bit;
+
+		if(destTerrain->isLand())
+			result.land |= bit;
+
+		if(srcWater && destTerrain->isWater() && dir.x && dir.y)
+		{
+			const int3 horizontalNeighbour = tile + int3{dir.x, 0, 0};
+			const int3 verticalNeighbour = tile + int3{0, dir.y, 0};
+			if(map.getTile(horizontalNeighbour).terType->isLand() || map.getTile(verticalNeighbour).terType->isLand())
+				result.coastBlocked |= bit;
+		}
+	}
+
+	masks[tile.x + sizes.x * (tile.y + sizes.y * tile.z)] = result;
+}
+
+VCMI_LIB_NAMESPACE_END
@@ -0,0 +1,50 @@
+/*
+ * TerrainNeighbourTable.h, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+
+#pragma once
+
+#include "../int3.h"
+
+VCMI_LIB_NAMESPACE_BEGIN
+
+class CMap;
+
+/// Neighbourhood of every map tile as seen by pathfinder, stored as bitmasks over TerrainNeighbourTable::dirs.
+/// Depends only on terrain types, so it has to be updated only for tiles around edited terrain
+class DLL_LINKAGE TerrainNeighbourTable
+{
+public:
+	struct Masks
+	{
+		ui8 passable = 0; //neighbour is inside of map and its terrain is passable
+		ui8 land = 0; //neighbour is land tile
+		ui8 coastBlocked = 0; //diagonal move between water tiles that cuts over coast
+	};
+
+	static const std::array<int3, 8> dirs;
+
+	explicit TerrainNeighbourTable(const CMap & map);
+
+	/// Recomputes masks of given tiles, set must include all neighbours of edited tiles
+	void update(const CMap & map, const std::set<int3> & tiles);
+
+	const Masks & get(const int3 & tile) const
+	{
+		return masks[tile.x + sizes.x * (tile.y + sizes.y * tile.z)];
+	}
+
+private:
+	void updateTile(const CMap & map, const int3 & tile);
+
+	int3 sizes;
+	std::vector<Masks> masks;
+};
+
+VCMI_LIB_NAMESPACE_END
@@ -29,6 +29,8 @@
 #include "../texts/Languages.h"
 #include "../VCMI_Lib.h"
 
+#include <tbb/parallel_for.h>
+
 VCMI_LIB_NAMESPACE_BEGIN
 
 static JsonNode loadModSettings(const JsonPath & path)
@@ -452,29 +454,37 @@ void CModHandler::loadTranslation(const TModID & modName)
 
 void CModHandler::load()
 {
-	CStopWatch totalTime;
-	CStopWatch timer;
+	CWallStopWatch totalTime;
+	CWallStopWatch timer;
 
 	logMod->info("\tInitializing content handler: %d ms", timer.getDiff());
 
 	content->init();
 
-	for(const TModID & modName : activeMods)
+	// checksums of mods are independent from each other
+	std::vector<ui32> checksums(activeMods.size());
+	tbb::parallel_for(static_cast<size_t>(0), activeMods.size(), [this, &checksums](size_t i)
 	{
-		logMod->trace("Generating checksum for %s", modName);
-		allMods[modName].updateChecksum(calculateModChecksum(modName, CResourceHandler::get(modName)));
+		checksums[i] = calculateModChecksum(activeMods[i], CResourceHandler::get(activeMods[i]));
+	});
+
+	for(size_t i = 0; i < activeMods.size(); ++i)
+	{
+		logMod->trace("Generated checksum for %s", activeMods[i]);
+		allMods[activeMods[i]].updateChecksum(checksums[i]);
 	}
+	logMod->info("\tCalculating mod checksums: %d ms", timer.getDiff());
 
 	// first - load virtual builtin mod that contains all data
 	// TODO? move all data into real mods? RoE, AB, SoD, WoG
-	content->preloadData(*coreMod);
+	std::vector<CModInfo *> loadedMods = { coreMod.get() };
 	for(const TModID & modName : activeMods)
-		content->preloadData(allMods[modName]);
+		loadedMods.push_back(&allMods[modName]);
+
+	content->preloadData(loadedMods);
 	logMod->info("\tParsing mod data: %d ms", timer.getDiff());
 
-	content->load(*coreMod);
-	for(const TModID & modName : activeMods)
-		content->load(allMods[modName]);
+	content->load(loadedMods);
 
 #if SCRIPTING_ENABLED
 	VLC->scriptHandler->performRegistration(VLC);//todo: this should be done before any other handlers load
@@ -39,6 +39,8 @@
 #include "../spells/CSpellHandler.h"
 #include "../VCMI_Lib.h"
 
+#include <tbb/parallel_for.h>
+
 VCMI_LIB_NAMESPACE_BEGIN
 
 ContentTypeHandler::ContentTypeHandler(IHandlerBase * handler, const std::string & entityName):
@@ -52,12 +54,15 @@ ContentTypeHandler::ContentTypeHandler(IHandlerBase * handler, const std::string
 	}
 }
 
-bool ContentTypeHandler::preloadModData(const std::string & modName, const JsonNode & fileList, bool validate)
+JsonNode ContentTypeHandler::readModData(const std::string & modName, const JsonNode & fileList, bool & isValid)
 {
-	bool result = false;
-	JsonNode data = JsonUtils::assembleFromFiles(fileList, result);
+	JsonNode data = JsonUtils::assembleFromFiles(fileList, isValid);
 	data.setModScope(modName);
+	return data;
+}
 
+void ContentTypeHandler::preloadModData(const std::string & modName, JsonNode data)
+{
 	ModInfo & modInfo = modData[modName];
 
 	for(auto entry : data.Struct())
@@ -87,19 +92,12 @@ bool ContentTypeHandler::preloadModData(const std::string & modName, const JsonN
 			JsonUtils::merge(remoteConf, entry.second);
 		}
 	}
-	return result;
 }
 
-bool ContentTypeHandler::loadMod(const std::string & modName, bool validate)
+std::vector<ContentTypeHandler::PreparedObject> ContentTypeHandler::prepareMod(const std::string & modName)
 {
 	ModInfo & modInfo = modData[modName];
-	bool result = true;
-
-	auto performValidate = [&,this](JsonNode & data, const std::string & name){
-		handler->beforeValidate(data);
-		if (validate)
-			result &= JsonUtils::validate(data, "vcmi:" + entityName, name);
-	};
+	std::vector<PreparedObject> result;
 
 	// apply patches
 	if (!modInfo.patches.isNull())
@@ -143,20 +141,33 @@ bool ContentTypeHandler::loadMod(const std::string & modName, bool validate)
 			{
 				logMod->trace("no original data in loadMod(%s) at index %d", name, index);
 			}
-			performValidate(data, name);
-			handler->loadObject(modName, name, data, index);
+			handler->beforeValidate(data);
+			result.push_back({name, &data, index});
 		}
 		else
 		{
 			// normal new object
 			logMod->trace("no index in loadMod(%s)", name);
-			performValidate(data,name);
-			handler->loadObject(modName, name, data);
+			handler->beforeValidate(data);
+			result.push_back({name, &data, std::nullopt});
 		}
 	}
 	return result;
 }
 
+bool ContentTypeHandler::validateObject(const PreparedObject & object) const
+{
+	return JsonUtils::validate(*object.data, "vcmi:" + entityName, object.name);
+}
+
+void ContentTypeHandler::loadObject(const std::string & modName, const PreparedObject & object)
+{
+	if (object.index)
+		handler->loadObject(modName, object.name, *object.data, *object.index);
+	else
+		handler->loadObject(modName, object.name, *object.data);
+}
+
 void ContentTypeHandler::loadCustom()
 {
 	handler->loadCustom();
@@ -255,75 +266,132 @@ void CContentHandler::init()
 	handlers.insert(std::make_pair("biomes", ContentTypeHandler(VLC->biomeHandler.get(), "biome")));
 }
 
-bool CContentHandler::preloadModData(const std::string & modName, JsonNode modConfig, bool validate)
+void CContentHandler::loadCustom()
 {
-	bool result = true;
 	for(auto & handler : handlers)
 	{
-		result &= handler.second.preloadModData(modName, modConfig[handler.first], validate);
+		handler.second.loadCustom();
 	}
-	return result;
 }
 
-bool CContentHandler::loadMod(const std::string & modName, bool validate)
+void CContentHandler::afterLoadFinalization()
 {
-	bool result = true;
 	for(auto & handler : handlers)
 	{
-		result &= handler.second.loadMod(modName, validate);
+		handler.second.afterLoadFinalization();
 	}
-	return result;
 }
 
-void CContentHandler::loadCustom()
+void CContentHandler::preloadData(const std::vector<CModInfo *> & mods)
 {
-	for(auto & handler : handlers)
+	CWallStopWatch timer;
+	std::vector<std::string> handlerNames;
+	for(const auto & handler : handlers)
+		handlerNames.push_back(handler.first);
+
+	std::vector<uint8_t> validate(mods.size());
+	for(size_t i = 0; i < mods.size(); ++i)
 	{
-		handler.second.loadCustom();
+		validate[i] = validateMod(*mods[i]);
+
+		// print message in format [<8-symbols checksum>] <modname>
+		auto & info = mods[i]->getVerificationInfo();
+		logMod->info("\t\t[%08x]%s", info.checksum, info.name);
 	}
-}
 
-void CContentHandler::afterLoadFinalization()
-{
-	for(auto & handler : handlers)
+	// mod.json and data files of mods do not depend on each other, so they are validated and parsed in parallel
+	std::vector<uint8_t> configValid(mods.size(), true);
+	tbb::parallel_for(static_cast<size_t>(0), mods.size(), [&](size_t i)
 	{
-		handler.second.afterLoadFinalization();
+		if (validate[i] && mods[i]->identifier != ModScope::scopeBuiltin())
+			configValid[i] = JsonUtils::validate(mods[i]->config, "vcmi:mod", mods[i]->identifier);
+	});
+
+	std::vector<JsonNode> files(mods.size() * handlerNames.size());
+	std::vector<uint8_t> filesValid(files.size(), false);
+	tbb::parallel_for(static_cast<size_t>(0), files.size(), [&](size_t task)
+	{
+		const CModInfo & mod = *mods[task / handlerNames.size()];
+		const JsonNode & config = mod.config;
+		bool isValid = false;
+
+		files[task] = ContentTypeHandler::readModData(mod.identifier, config[handlerNames[task % handlerNames.size()]], isValid);
+		filesValid[task] = isValid;
+	});
+	logMod->info("\t\tReading mod files: %d ms", timer.getDiff());
+
+	// patches from later mods must be merged on top of earlier ones, keep load order here
+	for(size_t i = 0; i < mods.size(); ++i)
+	{
+		bool result = configValid[i];
+		for(size_t j = 0; j < handlerNames.size(); ++j)
+		{
+			size_t task = i * handlerNames.size() + j;
+			handlers.at(handlerNames[j]).preloadModData(mods[i]->identifier, std::move(files[task]));
+			result &= filesValid[task];
+		}
+
+		if (!result)
+			mods[i]->validation = CModInfo::FAILED;
 	}
+	logMod->info("\t\tMerging mod data: %d ms", timer.getDiff());
 }
 
-void CContentHandler::preloadData(CModInfo & mod)
+void CContentHandler::load(const std::vector<CModInfo *> & mods)
 {
-	bool validate = validateMod(mod);
+	struct ModObject
+	{
+		size_t modIndex;
+		ContentTypeHandler * handler;
+		ContentTypeHandler::PreparedObject object;
+	};
 
-	// print message in format [<8-symbols checksum>] <modname>
-	auto & info = mod.getVerificationInfo();
-	logMod->info("\t\t[%08x]%s", info.checksum, info.name);
+	CWallStopWatch timer;
+	std::vector<ModObject> objects;
+	std::vector<uint8_t> validate(mods.size());
 
-	if (validate && mod.identifier != ModScope::scopeBuiltin())
+	for(size_t i = 0; i < mods.size(); ++i)
 	{
-		if (!JsonUtils::validate(mod.config, "vcmi:mod", mod.identifier))
-			mod.validation = CModInfo::FAILED;
+		validate[i] = validateMod(*mods[i]);
+
+		for(auto & handler : handlers)
+		{
+			for(const auto & object : handler.second.prepareMod(mods[i]->identifier))
+				objects.push_back({i, &handler.second, object});
+		}
 	}
-	if (!preloadModData(mod.identifier, mod.config, validate))
-		mod.validation = CModInfo::FAILED;
-}
 
-void CContentHandler::load(CModInfo & mod)
-{
-	bool validate = validateMod(mod);
+	// validation only reads object data, so all objects are checked at once
+	std::vector<uint8_t> objectValid(objects.size(), true);
+	tbb::parallel_for(static_cast<size_t>(0), objects.size(), [&](size_t i)
+	{
+		if (validate[objects[i].modIndex])
+			objectValid[i] = objects[i].handler->validateObject(objects[i].object);
+	});
+	logMod->info("\t\tValidating mod data: %d ms", timer.getDiff());
 
-	if (!loadMod(mod.identifier, validate))
-		mod.validation = CModInfo::FAILED;
+	// identifiers are registered in the same order as with sequential loading
+	for(size_t i = 0; i < objects.size(); ++i)
+	{
+		if (!objectValid[i])
+			mods[objects[i].modIndex]->validation = CModInfo::FAILED;
 
-	if (validate)
+		objects[i].handler->loadObject(mods[objects[i].modIndex]->identifier, objects[i].object);
+	}
+
+	for(size_t i = 0; i < mods.size(); ++i)
 	{
-		if (mod.validation != CModInfo::FAILED)
-			logMod->info("\t\t[DONE] %s", mod.getVerificationInfo().name);
+		if (validate[i])
+		{
+			if (mods[i]->validation != CModInfo::FAILED)
+				logMod->info("\t\t[DONE] %s", mods[i]->getVerificationInfo().name);
+			else
+				logMod->error("\t\t[FAIL] %s", mods[i]->getVerificationInfo().name);
+		}
 		else
-			logMod->error("\t\t[FAIL] %s", mod.getVerificationInfo().name);
+			logMod->info("\t\t[SKIP] %s", mods[i]->getVerificationInfo().name);
 	}
-	else
-		logMod->info("\t\t[SKIP] %s", mod.getVerificationInfo().name);
+	logMod->info("\t\tRegistering mod data: %d ms", timer.getDiff());
 }
 
 const ContentTypeHandler & CContentHandler::operator[](const std::string & name) const
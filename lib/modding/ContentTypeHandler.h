@@ -29,6 +29,13 @@ public:
 		/// mod data for this mod from other mods (patches)
 		JsonNode patches;
 	};
+	/// object of mod that is ready for validation and loading into handler
+	struct PreparedObject
+	{
+		std::string name;
+		JsonNode * data;
+		std::optional<size_t> index;
+	};
 	/// handler to which all data will be loaded
 	IHandlerBase * handler;
 	std::string entityName;
@@ -39,10 +46,17 @@ public:
 
 	ContentTypeHandler(IHandlerBase * handler, const std::string & objectName);
 
+	/// reads and parses files of mod, may be called from several threads at once
+	static JsonNode readModData(const std::string & modName, const JsonNode & fileList, bool & isValid);
+
 	/// local version of methods in ContentHandler
-	/// returns true if loading was successful
-	bool preloadModData(const std::string & modName, const JsonNode & fileList, bool validate);
-	bool loadMod(const std::string & modName, bool validate);
+	/// stores data read by readModData, must be called for mods in load order
+	void preloadModData(const std::string & modName, JsonNode data);
+	/// applies patches and returns objects of mod in order in which they must be loaded
+	std::vector<PreparedObject> prepareMod(const std::string & modName);
+	/// returns true if object matches schema, may be called from several threads at once
+	bool validateObject(const PreparedObject & object) const;
+	void loadObject(const std::string & modName, const PreparedObject & object);
 	void loadCustom();
 	void afterLoadFinalization();
 };
@@ -50,23 +64,19 @@ public:
 /// class used to load all game data into handlers. Used only during loading
 class DLL_LINKAGE CContentHandler
 {
-	/// preloads all data from fileList as data from modName.
-	bool preloadModData(const std::string & modName, JsonNode modConfig, bool validate);
-
-	/// actually loads data in mod
-	bool loadMod(const std::string & modName, bool validate);
-
 	std::map<std::string, ContentTypeHandler> handlers;
 
 	bool validateMod(const CModInfo & mod) const;
 public:
 	void init();
 
-	/// preloads all data from fileList as data from modName.
-	void preloadData(CModInfo & mod);
+	/// preloads all data of mods. Files are read and parsed in parallel,
+	/// but merged into handlers in order of the list
+	void preloadData(const std::vector<CModInfo *> & mods);
 
-	/// actually loads data in mod
-	void load(CModInfo & mod);
+	/// actually loads data in mods. Objects are validated in parallel,
+	/// but registered in handlers in order of the list
+	void load(const std::vector<CModInfo *> & mods);
 
 	void loadCustom();
 
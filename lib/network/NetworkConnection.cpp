@@ -69,7 +69,7 @@ void NetworkConnection::heartbeat()
 		if (!locked)
 			return;
 
-		locked->sendPacket({});
+		locked->sendPacket(std::vector<std::byte>());
 		locked->heartbeat();
 	});
 }
@@ -135,32 +135,34 @@ void NetworkConnection::setAsyncWritesEnabled(bool on)
 }
 
 void NetworkConnection::sendPacket(const std::vector<std::byte> & message)
+{
+	sendPacket(std::make_shared<const std::vector<std::byte>>(message));
+}
+
+void NetworkConnection::sendPacket(const NetworkPacket & message)
 {
 	std::lock_guard lock(writeMutex);
-	std::vector<std::byte> headerVector(sizeof(uint32_t));
-	uint32_t messageSize = message.size();
-	std::memcpy(headerVector.data(), &messageSize, sizeof(uint32_t));
+	QueuedPacket packet{static_cast<uint32_t>(message->size()), message};
 
 	// At the moment, vcmilobby *requires* async writes in order to handle multiple connections with different speeds and at optimal performance
 	// However server (and potentially - client) can not handle this mode and may shutdown either socket or entire asio service too early, before all writes are performed
 	if (asyncWritesEnabled)
 	{
+		dataToSend.push_back(std::move(packet));
 
-		bool messageQueueEmpty = dataToSend.empty();
-		dataToSend.push_back(headerVector);
-		if (!message.empty())
-			dataToSend.push_back(message);
-
-		if (messageQueueEmpty)
+		if (dataInFlight.empty())
 			doSendData();
-		//else - data sending loop is still active and still sending previous messages
+		//else - data sending loop is still active and will send this message together with all other queued ones
 	}
 	else
 	{
+		std::array<boost::asio::const_buffer, 2> buffers = {
+			boost::asio::buffer(&packet.header, sizeof(packet.header)),
+			boost::asio::buffer(*packet.payload)
+		};
+
 		boost::system::error_code ec;
-		boost::asio::write(*socket, boost::asio::buffer(headerVector), ec );
-		if (!message.empty())
-			boost::asio::write(*socket, boost::asio::buffer(message), ec );
+		boost::asio::write(*socket, buffers, ec);
 	}
 }
 
@@ -169,7 +171,19 @@ void NetworkConnection::doSendData()
 	if (dataToSend.empty())
 		throw std::runtime_error("Attempting to sent data but there is no data to send!");
 
-	boost::asio::async_write(*socket, boost::asio::buffer(dataToSend.front()), [self = shared_from_this()](const auto & error, const auto & )
+	std::swap(dataInFlight, dataToSend);
+
+	std::vector<boost::asio::const_buffer> buffers;
+	buffers.reserve(dataInFlight.size() * 2);
+
+	for (const auto & packet : dataInFlight)
+	{
+		buffers.push_back(boost::asio::buffer(&packet.header, sizeof(packet.header)));
+		if (!packet.payload->empty())
+			buffers.push_back(boost::asio::buffer(*packet.payload));
+	}
+
+	boost::asio::async_write(*socket, buffers, [self = shared_from_this()](const auto & error, const auto & )
 	{
 		self->onDataSent(error);
 	});
@@ -178,7 +192,7 @@ void NetworkConnection::doSendData()
 void NetworkConnection::onDataSent(const boost::system::error_code & ec)
 {
 	std::lock_guard lock(writeMutex);
-	dataToSend.pop_front();
+	dataInFlight.clear();
 	if (ec)
 	{
 		onError(ec.message());
@@ -18,7 +18,14 @@ class NetworkConnection final : public INetworkConnection, public std::enable_sh
 	static const int messageHeaderSize = sizeof(uint32_t);
 	static const int messageMaxSize = 64 * 1024 * 1024; // arbitrary size to prevent potential massive allocation if we receive garbage input
 
-	std::list<std::vector<std::byte>> dataToSend;
+	struct QueuedPacket
+	{
+		uint32_t header;
+		NetworkPacket payload;
+	};
+
+	std::vector<QueuedPacket> dataToSend; // packets that will be sent together once current write is over
+	std::vector<QueuedPacket> dataInFlight; // packets that are being sent by current write
 	std::shared_ptr<NetworkSocket> socket;
 	std::shared_ptr<NetworkTimer> timer;
 	std::mutex writeMutex;
@@ -43,6 +50,7 @@ public:
 	void start();
 	void close() override;
 	void sendPacket(const std::vector<std::byte> & message) override;
+	void sendPacket(const NetworkPacket & message) override;
 	void setAsyncWritesEnabled(bool on) override;
 };
 
@@ -11,12 +11,17 @@
 
 VCMI_LIB_NAMESPACE_BEGIN
 
+/// Packet data shared with network layer until it has been written to socket
+using NetworkPacket = std::shared_ptr<const std::vector<std::byte>>;
+
 /// Base class for connections with other services, either incoming or outgoing
 class DLL_LINKAGE INetworkConnection : boost::noncopyable
 {
 public:
 	virtual ~INetworkConnection() = default;
 	virtual void sendPacket(const std::vector<std::byte> & message) = 0;
+	/// Sends packet without copying it. Packet data must not be modified afterwards
+	virtual void sendPacket(const NetworkPacket & message) = 0;
 	virtual void setAsyncWritesEnabled(bool on) = 0;
 	virtual void close() = 0;
 };
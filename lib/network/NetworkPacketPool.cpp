@@ -0,0 +1,56 @@
+/*
+ * NetworkPacketPool.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#include "StdInc.h"
+#include "NetworkPacketPool.h"
+
+VCMI_LIB_NAMESPACE_BEGIN
+
+std::shared_ptr<std::vector<std::byte>> NetworkPacketPool::acquire()
+{
+	std::unique_ptr<std::vector<std::byte>> buffer;
+
+	{
+		std::lock_guard lock(mutex);
+		if (!freeBuffers.empty())
+		{
+			buffer = std::move(freeBuffers.back());
+			freeBuffers.pop_back();
+		}
+	}
+
+	if (!buffer)
+		buffer = std::make_unique<std::vector<std::byte>>();
+
+	return std::shared_ptr<std::vector<std::byte>>(buffer.release(), [pool = weak_from_this()](std::vector<std::byte> * released)
+	{
+		auto locked = pool.lock();
+
+		if (locked)
+			locked->release(released);
+		else
+			delete released;
+	});
+}
+
+void NetworkPacketPool::release(std::vector<std::byte> * buffer)
+{
+	std::unique_ptr<std::vector<std::byte>> owned(buffer);
+
+	if (owned->capacity() > maxBufferCapacity)
+		return;
+
+	owned->clear();
+
+	std::lock_guard lock(mutex);
+	if (freeBuffers.size() < maxFreeBuffers)
+		freeBuffers.push_back(std::move(owned));
+}
+
+VCMI_LIB_NAMESPACE_END
@@ -0,0 +1,31 @@
+/*
+ * NetworkPacketPool.h, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#pragma once
+
+VCMI_LIB_NAMESPACE_BEGIN
+
+/// Keeps buffers of already sent packets, so serialization of next packet usually needs no new allocation
+/// Must be owned by shared pointer, buffers return to pool only while pool is alive
+class DLL_LINKAGE NetworkPacketPool final : public std::enable_shared_from_this<NetworkPacketPool>, boost::noncopyable
+{
+	static constexpr size_t maxFreeBuffers = 8;
+	static constexpr size_t maxBufferCapacity = 1024 * 1024; // buffers of huge packets, like game state, are not kept
+
+	std::mutex mutex;
+	std::vector<std::unique_ptr<std::vector<std::byte>>> freeBuffers;
+
+	void release(std::vector<std::byte> * buffer);
+
+public:
+	/// Returns empty buffer which returns to the pool once last reference to it is gone
+	std::shared_ptr<std::vector<std::byte>> acquire();
+};
+
+VCMI_LIB_NAMESPACE_END
@@ -11,6 +11,7 @@
 #include "CPathfinder.h"
 
 #include "INodeStorage.h"
+#include "NodeStorage.h"
 #include "PathfinderOptions.h"
 #include "PathfindingRules.h"
 #include "TurnInfo.h"
@@ -22,8 +23,11 @@
 #include "../mapObjects/CGTownInstance.h"
 #include "../mapObjects/MiscObjects.h"
 #include "../mapping/CMap.h"
+#include "../mapping/TerrainNeighbourTable.h"
 #include "spells/CSpellHandler.h"
 
+#include <tbb/parallel_for.h>
+
 VCMI_LIB_NAMESPACE_BEGIN
 
 bool CPathfinderHelper::canMoveFromNode(const PathNodeInfo & source) const
@@ -237,6 +241,40 @@ void CPathfinder::calculatePaths()
 	logAi->trace("CPathfinder finished with %s iterations", std::to_string(counter));
 }
 
+void CPathfinder::calculatePaths(CGameState * gs, const std::vector<std::shared_ptr<SingleHeroPathfinderConfig>> & configs)
+{
+	using AccessibilityKey = std::tuple<PlayerColor, bool, bool>;
+	std::map<AccessibilityKey, std::shared_ptr<const PathfinderAccessibility>> accessibilityByOwner;
+	std::set<const CGHeroInstance *> heroes;
+
+	for(const auto & config : configs)
+	{
+		const PlayerColor owner = config->getHero()->tempOwner;
+		AccessibilityKey key(owner, config->options.useFlying, config->options.useWaterWalking);
+
+		auto & accessibility = accessibilityByOwner[key];
+		if(!accessibility)
+			accessibility = std::make_shared<PathfinderAccessibility>(config->options, gs, owner);
+
+		config->setSharedAccessibility(accessibility);
+
+		// Movement limits update army speed of the hero and bump bonus tree version when it changes.
+		// Do it here so that parallel searches only read hero state and do not invalidate bonus caches of each other
+		const CGHeroInstance * hero = config->getHero();
+		[[maybe_unused]] bool uniqueHero = heroes.insert(hero).second;
+		assert(uniqueHero);
+		hero->movementPointsLimit(true);
+		hero->movementPointsLimit(false);
+	}
+
+	// Bonus caches are locked per node, and the subtree of each hero is searched by single task
+	tbb::parallel_for(static_cast<size_t>(0), configs.size(), [gs, &configs](size_t index)
+	{
+		CPathfinder pathfinder(gs, configs[index]);
+		pathfinder.calculatePaths();
+	});
+}
+
 TeleporterTilesVector CPathfinderHelper::getAllowedTeleportChannelExits(const TeleportChannelID & channelID) const
 {
 	TeleporterTilesVector allowedExits;
@@ -499,7 +537,8 @@ CPathfinderHelper::CPathfinderHelper(CGameState * gs, const CGHeroInstance * Her
 	turn(-1),
 	hero(Hero),
 	options(Options),
-	owner(Hero->tempOwner)
+	owner(Hero->tempOwner),
+	neighbourTable(&gs->map->getTerrainNeighbourTable())
 {
 	turnsInfo.reserve(16);
 	updateTurnInfo();
@@ -581,43 +620,22 @@ void CPathfinderHelper::getNeighbours(
 	const boost::logic::tribool & onLand,
 	const bool limitCoastSailing) const
 {
-	CMap * map = gs->map;
+	const auto & masks = neighbourTable->get(srcCoord);
+	ui8 allowed = masks.passable;
 
-	static const int3 dirs[] = {
-		int3(-1, +1, +0),	int3(0, +1, +0),	int3(+1, +1, +0),
-		int3(-1, +0, +0),	/* source pos */	int3(+1, +0, +0),
-		int3(-1, -1, +0),	int3(0, -1, +0),	int3(+1, -1, +0)
-	};
+	/// Following condition let us avoid diagonal movement over coast when sailing
+	if(srcTile.terType->isWater() && limitCoastSailing)
+		allowed &= ~masks.coastBlocked;
 
-	for(const auto & dir : dirs)
-	{
-		const int3 destCoord = srcCoord + dir;
-		if(!map->isInTheMap(destCoord))
-			continue;
+	if(onLand == true)
+		allowed &= masks.land;
+	else if(onLand == false)
+		allowed &= ~masks.land;
 
-		const TerrainTile & destTile = map->getTile(destCoord);
-		if(!destTile.terType->isPassable())
-			continue;
-
-// 		//we cannot visit things from blocked tiles
-// 		if(srcTile.blocked && !srcTile.visitable && destTile.visitable && srcTile.blockingObjects.front()->ID != HEROI_TYPE)
-// 		{
-// 			continue;
-// 		}
-
-		/// Following condition let us avoid diagonal movement over coast when sailing
-		if(srcTile.terType->isWater() && limitCoastSailing && destTile.terType->isWater() && dir.x && dir.y) //diagonal move through water
-		{
-			const int3 horizontalNeighbour = srcCoord + int3{dir.x, 0, 0};
-			const int3 verticalNeighbour = srcCoord + int3{0, dir.y, 0};
-			if(map->getTile(horizontalNeighbour).terType->isLand() || map->getTile(verticalNeighbour).terType->isLand())
-				continue;
-		}
-
-		if(indeterminate(onLand) || onLand == destTile.terType->isLand())
-		{
-			vec.push_back(destCoord);
-		}
+	for(size_t i = 0; allowed; i++, allowed >>= 1)
+	{
+		if(allowed & 1)
+			vec.push_back(srcCoord + TerrainNeighbourTable::dirs[i]);
 	}
 }
 
@@ -21,6 +21,8 @@ VCMI_LIB_NAMESPACE_BEGIN
 class CGWhirlpool;
 struct TurnInfo;
 struct PathfinderOptions;
+class SingleHeroPathfinderConfig;
+class TerrainNeighbourTable;
 
 // Optimized storage - tile can have 0-8 neighbour tiles
 // static_vector uses fixed, preallocated storage (capacity) and dynamic size
@@ -41,6 +43,14 @@ public:
 
 	void calculatePaths(); //calculates possible paths for hero, uses current hero position and movement left; returns pointer to newly allocated CPath or nullptr if path does not exists
 
+	/// Every hero of a batch needs its own full CPathsInfo grid, so callers should split heroes into batches of this size
+	static constexpr size_t MAX_BATCH_SIZE = 4;
+
+	/// Calculates paths for several heroes in one go. Map accessibility is evaluated once per player
+	/// and shared between node storages, searches of individual heroes then run in parallel.
+	/// Each hero may appear only once, game state must not change until the call returns
+	static void calculatePaths(CGameState * gs, const std::vector<std::shared_ptr<SingleHeroPathfinderConfig>> & configs);
+
 private:
 	CGameState * gamestate;
 
@@ -138,6 +148,9 @@ public:
 	bool passOneTurnLimitCheck(const PathNodeInfo & source) const;
 
 	int getGuardiansCount(int3 tile) const;
+
+private:
+	const TerrainNeighbourTable * neighbourTable;
 };
 
 VCMI_LIB_NAMESPACE_END
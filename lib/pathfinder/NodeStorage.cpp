@@ -21,12 +21,13 @@
 
 VCMI_LIB_NAMESPACE_BEGIN
 
-void NodeStorage::initialize(const PathfinderOptions & options, const CGameState * gs)
+/// Evaluates accessibility of all tiles on layers enabled by options and passes it to visitor
+template<typename Visitor>
+static void evaluateAccessibility(const PathfinderOptions & options, const CGameState * gs, const PlayerColor & player, const Visitor & visitor)
 {
-	//TODO: fix this code duplication with AINodeStorage::initialize, problem is to keep `resetTile` inline
+	using ELayer = EPathfindingLayer;
 
 	int3 pos;
-	const PlayerColor player = out.hero->tempOwner;
 	const int3 sizes = gs->getMapSize();
 	const auto & fow = static_cast<const CGameInfoCallback *>(gs)->getPlayerTeam(player)->fogOfWarMap;
 
@@ -43,23 +44,75 @@ void NodeStorage::initialize(const PathfinderOptions & options, const CGameState
 				const TerrainTile & tile = gs->map->getTile(pos);
 				if(tile.terType->isWater())
 				{
-					resetTile(pos, ELayer::SAIL, PathfinderUtil::evaluateAccessibility<ELayer::SAIL>(pos, tile, fow, player, gs));
+					visitor(pos, ELayer::SAIL, PathfinderUtil::evaluateAccessibility<ELayer::SAIL>(pos, tile, fow, player, gs));
 					if(useFlying)
-						resetTile(pos, ELayer::AIR, PathfinderUtil::evaluateAccessibility<ELayer::AIR>(pos, tile, fow, player, gs));
+						visitor(pos, ELayer::AIR, PathfinderUtil::evaluateAccessibility<ELayer::AIR>(pos, tile, fow, player, gs));
 					if(useWaterWalking)
-						resetTile(pos, ELayer::WATER, PathfinderUtil::evaluateAccessibility<ELayer::WATER>(pos, tile, fow, player, gs));
+						visitor(pos, ELayer::WATER, PathfinderUtil::evaluateAccessibility<ELayer::WATER>(pos, tile, fow, player, gs));
 				}
 				if(tile.terType->isLand())
 				{
-					resetTile(pos, ELayer::LAND, PathfinderUtil::evaluateAccessibility<ELayer::LAND>(pos, tile, fow, player, gs));
+					visitor(pos, ELayer::LAND, PathfinderUtil::evaluateAccessibility<ELayer::LAND>(pos, tile, fow, player, gs));
 					if(useFlying)
-						resetTile(pos, ELayer::AIR, PathfinderUtil::evaluateAccessibility<ELayer::AIR>(pos, tile, fow, player, gs));
+						visitor(pos, ELayer::AIR, PathfinderUtil::evaluateAccessibility<ELayer::AIR>(pos, tile, fow, player, gs));
 				}
 			}
 		}
 	}
 }
 
+PathfinderAccessibility::PathfinderAccessibility(const PathfinderOptions & options, const CGameState * gs, const PlayerColor & player)
+	: useFlying(options.useFlying)
+	, useWaterWalking(options.useWaterWalking)
+	, sizes(gs->getMapSize())
+	, accessibility(static_cast<size_t>(EPathfindingLayer::NUM_LAYERS) * sizes.z * sizes.x * sizes.y, EPathAccessibility::NOT_SET)
+{
+	evaluateAccessibility(options, gs, player, [this](const int3 & pos, EPathfindingLayer layer, EPathAccessibility value)
+	{
+		accessibility[((layer.getNum() * sizes.z + pos.z) * sizes.x + pos.x) * sizes.y + pos.y] = value;
+	});
+}
+
+void NodeStorage::initialize(const PathfinderOptions & options, const CGameState * gs)
+{
+	//TODO: fix this code duplication with AINodeStorage::initialize, problem is to keep `resetTile` inline
+
+	if(sharedAccessibility)
+	{
+		assert(sharedAccessibility->useFlying == options.useFlying && sharedAccessibility->useWaterWalking == options.useWaterWalking);
+
+		int3 pos;
+		const int3 & sizes = sharedAccessibility->getSizes();
+
+		for(EPathfindingLayer layer = EPathfindingLayer::LAND; layer < EPathfindingLayer::NUM_LAYERS; layer.advance(1))
+		{
+			for(pos.z=0; pos.z < sizes.z; ++pos.z)
+			{
+				for(pos.x=0; pos.x < sizes.x; ++pos.x)
+				{
+					for(pos.y=0; pos.y < sizes.y; ++pos.y)
+					{
+						EPathAccessibility accessibility = sharedAccessibility->get(pos, layer);
+						if(accessibility != EPathAccessibility::NOT_SET)
+							resetTile(pos, layer, accessibility);
+					}
+				}
+			}
+		}
+		return;
+	}
+
+	evaluateAccessibility(options, gs, out.hero->tempOwner, [this](const int3 & pos, EPathfindingLayer layer, EPathAccessibility value)
+	{
+		resetTile(pos, layer, value);
+	});
+}
+
+void NodeStorage::setSharedAccessibility(std::shared_ptr<const PathfinderAccessibility> accessibility)
+{
+	sharedAccessibility = std::move(accessibility);
+}
+
 void NodeStorage::calculateNeighbours(
 	std::vector<CGPathNode *> & result,
 	const PathNodeInfo & source,
@@ -14,10 +14,36 @@
 
 VCMI_LIB_NAMESPACE_BEGIN
 
+/// Accessibility of every tile and layer as seen by one player. Evaluating it takes most of NodeStorage::initialize,
+/// and it does not depend on the hero, so storages of all heroes of a player can share one snapshot
+class DLL_LINKAGE PathfinderAccessibility
+{
+public:
+	PathfinderAccessibility(const PathfinderOptions & options, const CGameState * gs, const PlayerColor & player);
+
+	EPathAccessibility get(const int3 & tile, EPathfindingLayer layer) const
+	{
+		return accessibility[((layer.getNum() * sizes.z + tile.z) * sizes.x + tile.x) * sizes.y + tile.y];
+	}
+
+	const int3 & getSizes() const
+	{
+		return sizes;
+	}
+
+	bool useFlying;
+	bool useWaterWalking;
+
+private:
+	int3 sizes;
+	std::vector<EPathAccessibility> accessibility; //NOT_SET for layers not present on tile
+};
+
 class DLL_LINKAGE NodeStorage : public INodeStorage
 {
 private:
 	CPathsInfo & out;
+	std::shared_ptr<const PathfinderAccessibility> sharedAccessibility;
 
 	STRONG_INLINE
 	void resetTile(const int3 & tile, const EPathfindingLayer & layer, EPathAccessibility accessibility);
@@ -32,6 +58,8 @@ public:
 	}
 
 	void initialize(const PathfinderOptions & options, const CGameState * gs) override;
+	/// Next initialize() copies accessibility from snapshot instead of evaluating every tile again
+	void setSharedAccessibility(std::shared_ptr<const PathfinderAccessibility> accessibility);
 	virtual ~NodeStorage() = default;
 
 	std::vector<CGPathNode *> getInitialNodes() override;
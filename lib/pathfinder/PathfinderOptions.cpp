@@ -70,4 +70,17 @@ CPathfinderHelper * SingleHeroPathfinderConfig::getOrCreatePathfinderHelper(cons
 	return pathfinderHelper.get();
 }
 
+const CGHeroInstance * SingleHeroPathfinderConfig::getHero() const
+{
+	return pathfinderHelper->hero;
+}
+
+void SingleHeroPathfinderConfig::setSharedAccessibility(std::shared_ptr<const PathfinderAccessibility> accessibility)
+{
+	auto storage = std::dynamic_pointer_cast<NodeStorage>(nodeStorage);
+	assert(storage);
+	if(storage)
+		storage->setSharedAccessibility(std::move(accessibility));
+}
+
 VCMI_LIB_NAMESPACE_END
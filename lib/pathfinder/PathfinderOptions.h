@@ -17,6 +17,7 @@ class CPathfinderHelper;
 class CGameState;
 class CGHeroInstance;
 class CGameInfoCallback;
+class PathfinderAccessibility;
 struct PathNodeInfo;
 struct CPathsInfo;
 
@@ -115,6 +116,10 @@ public:
 
 	CPathfinderHelper * getOrCreatePathfinderHelper(const PathNodeInfo & source, CGameState * gs) override;
 
+	const CGHeroInstance * getHero() const;
+	/// Lets node storage reuse accessibility evaluated for another hero of the same player
+	void setSharedAccessibility(std::shared_ptr<const PathfinderAccessibility> accessibility);
+
 	static std::vector<std::shared_ptr<IPathfindingRule>> buildRuleSet();
 };
 
@@ -44,6 +44,29 @@ TurnInfo::TurnInfo(const CGHeroInstance * Hero, const int turn):
 	bonuses = hero->getAllBonuses(Selector::days(turn), Selector::all, "");
 	bonusCache = std::make_unique<BonusCache>(bonuses);
 	nativeTerrain = hero->getNativeTerrain();
+	updateTerrainMovementCosts();
+}
+
+void TurnInfo::updateTerrainMovementCosts() const
+{
+	terrainMovementCost.assign(VLC->terrainTypeHandler->objects.size(), GameConstants::BASE_MOVEMENT_COST);
+
+	if(nativeTerrain == ETerrainId::ANY_TERRAIN) //no special creature bonus
+		return;
+
+	for(const auto & terrain : VLC->terrainTypeHandler->objects)
+	{
+		if(nativeTerrain == terrain->getId() || bonusCache->noTerrainPenalty.count(terrain->getId()))
+			continue;
+
+		int64_t cost = terrain->moveCost - bonusCache->pathfindingVal;
+		terrainMovementCost[terrain->getIndex()] = static_cast<ui32>(std::max<int64_t>(cost, GameConstants::BASE_MOVEMENT_COST));
+	}
+}
+
+ui32 TurnInfo::getTerrainMovementCost(const TerrainId & terrain) const
+{
+	return terrainMovementCost[terrain.getNum()];
 }
 
 bool TurnInfo::isLayerAvailable(const EPathfindingLayer & layer) const
@@ -142,6 +165,7 @@ void TurnInfo::updateHeroBonuses(BonusType type, const CSelector& sel) const
 		break;
 	case BonusType::ROUGH_TERRAIN_DISCOUNT:
 		bonusCache->pathfindingVal = bonuses->valOfBonuses(Selector::type()(BonusType::ROUGH_TERRAIN_DISCOUNT));
+		updateTerrainMovementCosts();
 		break;
 	default:
 		bonuses = hero->getAllBonuses(Selector::days(turn), Selector::all, "");
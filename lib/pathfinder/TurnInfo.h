@@ -39,6 +39,8 @@ struct DLL_LINKAGE TurnInfo
 	mutable int maxMovePointsWater;
 	TerrainId nativeTerrain;
 	int turn;
+	/// Cost of moving from tile of given terrain without road, indexed by terrain id
+	mutable std::vector<ui32> terrainMovementCost;
 
 	TurnInfo(const CGHeroInstance * Hero, const int Turn = 0);
 	bool isLayerAvailable(const EPathfindingLayer & layer) const;
@@ -48,6 +50,10 @@ struct DLL_LINKAGE TurnInfo
 	int valOfBonuses(const BonusType type, const BonusSubtypeID subtype) const;
 	void updateHeroBonuses(BonusType type, const CSelector& sel) const;
 	int getMaxMovePoints(const EPathfindingLayer & layer) const;
+	ui32 getTerrainMovementCost(const TerrainId & terrain) const;
+
+private:
+	void updateTerrainMovementCosts() const;
 };
 
 VCMI_LIB_NAMESPACE_END
@@ -29,7 +29,7 @@
 #include "Zone.h"
 #include "Functions.h"
 #include "RmgMap.h"
-#include "threadpool/ThreadPool.h"
+#include "threadpool/ModificatorScheduler.h"
 #include "modificators/ObjectManager.h"
 #include "modificators/TreasurePlacer.h"
 #include "modificators/RoadPlacer.h"
@@ -55,6 +55,11 @@ int CMapGenerator::getRandomSeed() const
 	return randomSeed;
 }
 
+const std::map<std::string, CMapGenerator::ModificatorTime> & CMapGenerator::getModificatorTimes() const
+{
+	return modificatorTimes;
+}
+
 void CMapGenerator::loadConfig()
 {
 	JsonNode randomMapJson(JsonPath::builtin("config/randomMap.json"));
@@ -329,11 +334,33 @@ void CMapGenerator::addWaterTreasuresInfo()
 	}
 }
 
+static std::map<std::string, CMapGenerator::ModificatorTime> measureModificators(const TModificators & modificators)
+{
+	std::map<std::string, CMapGenerator::ModificatorTime> result;
+
+	for (const auto & modificator : modificators)
+	{
+		auto & stage = result[modificator->getName()];
+		stage.total += modificator->getProcessTime();
+		stage.longest = std::max(stage.longest, modificator->getProcessTime());
+		stage.zones++;
+		if (modificator->hasFailed())
+			stage.failures++;
+	}
+
+	for (const auto & stage : result)
+	{
+		logGlobal->debug("Modificator %s: %d ms total, %d ms in slowest zone, %d zones", stage.first, stage.second.total.count(), stage.second.longest.count(), stage.second.zones);
+	}
+	return result;
+}
+
 void CMapGenerator::fillZones()
 {
 	addWaterTreasuresInfo();
 
 	logGlobal->info("Started filling zones");
+	auto fillStart = std::chrono::steady_clock::now();
 
 	size_t numZones = map->getZones().size();
 
@@ -355,6 +382,7 @@ void CMapGenerator::fillZones()
 	{
 		allJobs.splice(allJobs.end(), it.second->getModificators());
 	}
+	const TModificators modificatorsToReport = allJobs;
 
 	Load::Progress::setupStepsTill(allJobs.size(), 240);
 
@@ -381,45 +409,16 @@ void CMapGenerator::fillZones()
 	}
 	else
 	{
-		ThreadPool pool;
-		std::vector<boost::future<void>> futures;
 		//At most one Modificator can run for every zone
-		pool.init(std::min<int>(boost::thread::hardware_concurrency(), numZones));
-
-		while (!allJobs.empty())
+		ModificatorScheduler scheduler(allJobs);
+		scheduler.run(std::min<size_t>(boost::thread::hardware_concurrency(), numZones), [this]()
 		{
-			for (auto it = allJobs.begin(); it != allJobs.end();)
-			{
-				if ((*it)->isFinished())
-				{
-					it = allJobs.erase(it);
-					Progress::Progress::step();
-				}
-				else if ((*it)->isReady())
-				{
-					auto jobCopy = *it;
-					futures.emplace_back(pool.async([this, jobCopy]() -> void
-						{
-							jobCopy->run();
-							Progress::Progress::step(); //Update progress bar
-						}
-					));
-					it = allJobs.erase(it);
-				}
-				else
-				{
-					++it;
-				}
-			}
-		}
-
-		//Wait for all the tasks
-		for (auto& fut : futures)
-		{
-			fut.get();
-		}
+			Progress::Progress::step(); //Update progress bar
+		});
 	}
 
+	modificatorTimes = measureModificators(modificatorsToReport);
+
 	for (const auto& it : map->getZones())
 	{
 		if (it.second->getType() == ETemplateZoneType::TREASURE)
@@ -438,7 +437,8 @@ void CMapGenerator::fillZones()
 	map->getMap(this).grailPos = *RandomGeneratorUtil::nextItem(grailZone->freePaths()->getTiles(), *rand);
 	map->getMap(this).reindexObjects();
 
-	logGlobal->info("Zones filled successfully");
+	auto fillTime = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - fillStart);
+	logGlobal->info("Zones filled successfully in %d ms", fillTime.count());
 
 	Load::Progress::set(250);
 }
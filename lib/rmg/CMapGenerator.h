@@ -55,6 +55,14 @@ public:
 		std::vector<int> questRewardValues;
 		bool singleThread;
 	};
+
+	struct ModificatorTime
+	{
+		std::chrono::milliseconds total{0};
+		std::chrono::milliseconds longest{0};
+		int zones = 0;
+		int failures = 0;
+	};
 	
 	explicit CMapGenerator(CMapGenOptions& mapGenOptions, IGameCallback * cb, int RandomSeed);
 	~CMapGenerator(); // required due to std::unique_ptr
@@ -76,6 +84,8 @@ public:
 	void addWaterTreasuresInfo();
 
 	int getRandomSeed() const;
+	/// Time spent by every kind of modificator during generate(), summed over all zones
+	const std::map<std::string, ModificatorTime> & getModificatorTimes() const;
 	
 private:
 	std::unique_ptr<vstd::RNG> rand;
@@ -86,6 +96,7 @@ private:
 	std::shared_ptr<CZonePlacer> placer;
 	
 	std::vector<rmg::ZoneConnection> connectionsLeft;
+	std::map<std::string, ModificatorTime> modificatorTimes;
 	
 	int monolithIndex;
 	std::vector<ArtifactID> questArtifacts;
@@ -22,6 +22,7 @@
 #include "Zone.h"
 #include "Functions.h"
 #include "PenroseTiling.h"
+#include "threadpool/ThreadPool.h"
 
 #include <vstd/RNG.h>
 
@@ -849,6 +850,50 @@ float CZonePlacer::metric (const int3 &A, const int3 &B) const
 
 }
 
+/// Calls closest(pos) for every tile of the level and stores returned index in flat [x][y] grid
+/// Columns are split between threads, so result does not depend on scheduling
+template<typename Func>
+static std::vector<size_t> labelTiles(int width, int height, int level, const Func & closest)
+{
+	static constexpr int columnsPerJob = 8;
+
+	std::vector<size_t> labels(width * height);
+
+	auto labelColumns = [&labels, &closest, width, height, level](int firstColumn)
+	{
+		int3 pos(0, 0, level);
+
+		for(pos.x = firstColumn; pos.x < std::min(width, firstColumn + columnsPerJob); pos.x++)
+		{
+			for(pos.y = 0; pos.y < height; pos.y++)
+				labels[pos.x * height + pos.y] = closest(pos);
+		}
+	};
+
+	size_t threads = std::min<size_t>(boost::thread::hardware_concurrency(), (width + columnsPerJob - 1) / columnsPerJob);
+
+	if(threads <= 1)
+	{
+		for(int column = 0; column < width; column += columnsPerJob)
+			labelColumns(column);
+
+		return labels;
+	}
+
+	ThreadPool pool;
+	std::vector<boost::future<void>> futures;
+
+	pool.init(threads);
+
+	for(int column = 0; column < width; column += columnsPerJob)
+		futures.push_back(pool.async([&labelColumns, column](){ labelColumns(column); }));
+
+	for(auto & future : futures)
+		future.get();
+
+	return labels;
+}
+
 void CZonePlacer::assignZones(vstd::RNG * rand)
 {
 	logGlobal->info("Starting zone colouring");
@@ -875,12 +920,6 @@ void CZonePlacer::assignZones(vstd::RNG * rand)
 		return lhs.second / lhs.first->getSize() < rhs.second / rhs.first->getSize();
 	};
 
-	auto simpleCompareByDistance = [](const Dpair & lhs, const Dpair & rhs) -> bool
-	{
-		//bigger zones have smaller distance
-		return lhs.second < rhs.second;
-	};
-
 	auto moveZoneToCenterOfMass = [width, height](const std::shared_ptr<Zone> & zone) -> void
 	{
 		int3 total(0, 0, 0);
@@ -909,16 +948,35 @@ void CZonePlacer::assignZones(vstd::RNG * rand)
 
 	for(pos.z = 0; pos.z < levels; pos.z++)
 	{
-		for(pos.x = 0; pos.x < width; pos.x++)
+		std::vector<Dpair> levelZones;
+		for(const auto & zone : zonesOnLevel[pos.z])
+			levelZones.emplace_back(zone.second, 0.f);
+
+		auto labels = labelTiles(width, height, pos.z, [&levelZones, &compareByDistance](const int3 & tile) -> size_t
 		{
-			for(pos.y = 0; pos.y < height; pos.y++)
+			//same as min_element - first of closest zones wins
+			size_t closest = 0;
+			Dpair best(levelZones[0].first, static_cast<float>(tile.dist2dSQ(levelZones[0].first->getPos())));
+
+			for(size_t i = 1; i < levelZones.size(); i++)
 			{
-				distances.clear();
-				for(const auto & zone : zonesOnLevel[pos.z])
+				Dpair candidate(levelZones[i].first, static_cast<float>(tile.dist2dSQ(levelZones[i].first->getPos())));
+
+				if(compareByDistance(candidate, best))
 				{
-					distances.emplace_back(zone.second, static_cast<float>(pos.dist2dSQ(zone.second->getPos())));
+					best = candidate;
+					closest = i;
 				}
-				boost::min_element(distances, compareByDistance)->first->area()->add(pos); //closest tile belongs to zone
+			}
+			return closest;
+		});
+
+		//tiles are added in the same order as before to keep generation reproducible
+		for(pos.x = 0; pos.x < width; pos.x++)
+		{
+			for(pos.y = 0; pos.y < height; pos.y++)
+			{
+				levelZones[labels[pos.x * height + pos.y]].first->area()->add(pos); //closest tile belongs to zone
 			}
 		}
 	}
@@ -957,23 +1015,38 @@ void CZonePlacer::assignZones(vstd::RNG * rand)
 		}
 
 		//Assign actual tiles to each zone
-		pos.z = level;
-		for (pos.x = 0; pos.x < width; pos.x++)
+		std::vector<std::pair<std::shared_ptr<Zone>, int3>> zoneVertices;
+		for(const auto & zoneVertex : vertexMapping)
 		{
-			for (pos.y = 0; pos.y < height; pos.y++)
+			for(const auto & vertex : zoneVertex.second)
+				zoneVertices.emplace_back(zoneVertex.first, vertex);
+		}
+
+		auto labels = labelTiles(width, height, level, [this, &zoneVertices](const int3 & tile) -> size_t
+		{
+			//Tile closest to vertex belongs to zone, first of equally close ones wins
+			size_t closest = 0;
+			float bestDistance = metric(tile, zoneVertices[0].second);
+
+			for(size_t i = 1; i < zoneVertices.size(); i++)
 			{
-				distances.clear();
-				for(const auto & zoneVertex : vertexMapping)
+				float distance = metric(tile, zoneVertices[i].second);
+
+				if(distance < bestDistance)
 				{
-					auto zone = zoneVertex.first;
-					for (const auto & vertex : zoneVertex.second)
-					{
-						distances.emplace_back(zone, metric(pos, vertex));
-					}
+					bestDistance = distance;
+					closest = i;
 				}
+			}
+			return closest;
+		});
 
-				//Tile closest to vertex belongs to zone
-				auto closestZone = boost::min_element(distances, simpleCompareByDistance)->first;
+		pos.z = level;
+		for (pos.x = 0; pos.x < width; pos.x++)
+		{
+			for (pos.y = 0; pos.y < height; pos.y++)
+			{
+				auto closestZone = zoneVertices[labels[pos.x * height + pos.y]].first;
 				closestZone->area()->add(pos);
 				map.setZoneID(pos, closestZone->getId());
 			}
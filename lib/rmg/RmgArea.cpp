@@ -32,6 +32,127 @@ void toRelative(Tileset & tiles, const int3 & position)
 	toAbsolute(tiles, -position);
 }
 
+TileBitmap::TileBitmap(const Tileset & tiles, int margin)
+{
+	if(tiles.empty())
+		return;
+
+	int3 minCorner = *tiles.begin();
+	int3 maxCorner = minCorner;
+
+	for(const auto & tile : tiles)
+	{
+		minCorner = int3(std::min(minCorner.x, tile.x), std::min(minCorner.y, tile.y), std::min(minCorner.z, tile.z));
+		maxCorner = int3(std::max(maxCorner.x, tile.x), std::max(maxCorner.y, tile.y), std::max(maxCorner.z, tile.z));
+	}
+
+	origin = minCorner - int3(margin, margin, 0);
+	size = maxCorner - minCorner + int3(2 * margin + 1, 2 * margin + 1, 1);
+	wordsPerRow = (size.x + bitsPerWord - 1) / bitsPerWord;
+	words.resize(static_cast<size_t>(wordsPerRow) * size.y * size.z);
+
+	for(const auto & tile : tiles)
+		add(tile);
+}
+
+size_t TileBitmap::rowIndex(int y, int z) const
+{
+	return (static_cast<size_t>(z) * size.y + y) * wordsPerRow;
+}
+
+bool TileBitmap::contains(const int3 & tile) const
+{
+	int3 local = tile - origin;
+
+	if(local.x < 0 || local.y < 0 || local.z < 0 || local.x >= size.x || local.y >= size.y || local.z >= size.z)
+		return false;
+
+	return (words[rowIndex(local.y, local.z) + local.x / bitsPerWord] >> (local.x % bitsPerWord)) & 1;
+}
+
+bool TileBitmap::empty() const
+{
+	return std::all_of(words.begin(), words.end(), [](Word word){ return word == 0; });
+}
+
+void TileBitmap::clear()
+{
+	std::fill(words.begin(), words.end(), 0);
+}
+
+void TileBitmap::add(const int3 & tile)
+{
+	int3 local = tile - origin;
+	assert(local.x >= 0 && local.y >= 0 && local.z >= 0);
+	assert(local.x < size.x && local.y < size.y && local.z < size.z);
+
+	words[rowIndex(local.y, local.z) + local.x / bitsPerWord] |= Word(1) << (local.x % bitsPerWord);
+}
+
+void TileBitmap::erase(const int3 & tile)
+{
+	if(!contains(tile))
+		return;
+
+	int3 local = tile - origin;
+	words[rowIndex(local.y, local.z) + local.x / bitsPerWord] &= ~(Word(1) << (local.x % bitsPerWord));
+}
+
+std::vector<TileBitmap::Word> TileBitmap::shiftedRowsX(int shift) const
+{
+	// bit x of result is bit x - shift of source, bits shifted in from outside of row are empty
+	std::vector<Word> result(words.size());
+
+	for(size_t row = 0; row < words.size(); row += wordsPerRow)
+	{
+		for(int i = 0; i < wordsPerRow; i++)
+		{
+			Word word = words[row + i];
+
+			if(shift > 0)
+			{
+				Word carry = i > 0 ? words[row + i - 1] >> (bitsPerWord - 1) : 0;
+				result[row + i] = (word << 1) | carry;
+			}
+			else
+			{
+				Word carry = i + 1 < wordsPerRow ? words[row + i + 1] << (bitsPerWord - 1) : 0;
+				result[row + i] = (word >> 1) | carry;
+			}
+		}
+	}
+
+	return result;
+}
+
+TileBitmap TileBitmap::eroded() const
+{
+	// 3x3 square is separable - erode along y first, then along x
+	TileBitmap vertical(*this);
+
+	for(int z = 0; z < size.z; z++)
+	{
+		for(int y = 0; y < size.y; y++)
+		{
+			for(int i = 0; i < wordsPerRow; i++)
+			{
+				Word above = y > 0 ? words[rowIndex(y - 1, z) + i] : 0;
+				Word below = y + 1 < size.y ? words[rowIndex(y + 1, z) + i] : 0;
+
+				vertical.words[rowIndex(y, z) + i] &= above & below;
+			}
+		}
+	}
+
+	auto left = vertical.shiftedRowsX(1);
+	auto right = vertical.shiftedRowsX(-1);
+
+	for(size_t i = 0; i < words.size(); i++)
+		vertical.words[i] &= left[i] & right[i];
+
+	return vertical;
+}
+
 Area::Area(const Area & area): dTiles(area.dTiles), dTotalShiftCache(area.dTotalShiftCache)
 {
 }
@@ -108,12 +229,20 @@ std::list<Area> connectedAreas(const Area & area, bool disableDiagonalConnection
 		dirs.assign(rmg::dirs4.begin(), rmg::dirs4.end());
 	
 	std::list<Area> result;
-	Tileset connected = area.getTiles();
-	while(!connected.empty())
+	const auto & tiles = area.getTiles();
+	TileBitmap connected(tiles);
+	TileBitmap queued(tiles);
+	queued.clear();
+
+	// areas are started in iteration order of tiles and filled in BFS order, so results do not depend on bitmap layout
+	for(const auto & start : tiles)
 	{
+		if(!connected.contains(start))
+			continue;
+
 		result.emplace_back();
-		std::list<int3> queue({*connected.begin()});
-		std::set<int3> queueSet({*connected.begin()});
+		std::list<int3> queue({start});
+		queued.add(start);
 		while(!queue.empty())
 		{
 			auto t = queue.front();
@@ -124,9 +253,9 @@ std::list<Area> connectedAreas(const Area & area, bool disableDiagonalConnection
 			for(auto & i : dirs)
 			{
 				auto tile = t + i;
-				if(!queueSet.count(tile) && connected.count(tile) && !result.back().contains(tile))
+				if(!queued.contains(tile) && connected.contains(tile))
 				{
-					queueSet.insert(tile);
+					queued.add(tile);
 					queue.push_back(tile);
 				}
 			}
@@ -161,12 +290,13 @@ const Tileset & Area::getBorder() const
 		return dBorderCache;
 	
 	//compute border cache
+	TileBitmap tiles(dTiles);
 	dBorderCache.reserve(dTiles.bucket_count());
 	for(const auto & t : dTiles)
 	{
 		for(auto & i : int3::getDirs())
 		{
-			if(!dTiles.count(t + i))
+			if(!tiles.contains(t + i))
 			{
 				dBorderCache.insert(t + dTotalShiftCache);
 				break;
@@ -183,12 +313,13 @@ const Tileset & Area::getBorderOutside() const
 		return dBorderOutsideCache;
 	
 	//compute outside border cache
+	TileBitmap tiles(dTiles);
 	dBorderOutsideCache.reserve(dBorderCache.bucket_count() * 2);
 	for(const auto & t : dTiles)
 	{
 		for(auto & i : int3::getDirs())
 		{
-			if(!dTiles.count(t + i))
+			if(!tiles.contains(t + i))
 				dBorderOutsideCache.insert(t + i + dTotalShiftCache);
 		}
 	}
@@ -200,15 +331,29 @@ DistanceMap Area::computeDistanceMap(std::map<int, Tileset> & reverseDistanceMap
 {
 	reverseDistanceMap.clear();
 	DistanceMap result;
-	auto area = *this;
+	const auto & tiles = getTiles();
+	TileBitmap remaining(tiles);
 	int distance = 0;
 	
-	while(!area.empty())
+	// each layer is the border of what remains after peeling off previous layers
+	// tiles are visited in iteration order of area so that layers are filled the same way as repeated getBorder() would do
+	while(!remaining.empty())
 	{
-		for(const auto & tile : area.getBorder())
-			result[tile] = distance;
-		reverseDistanceMap[distance++] = area.getBorder();
-		area.subtract(area.getBorder());
+		TileBitmap inner = remaining.eroded();
+		Tileset border;
+		border.reserve(tiles.bucket_count());
+
+		for(const auto & tile : tiles)
+		{
+			if(remaining.contains(tile) && !inner.contains(tile))
+			{
+				border.insert(tile);
+				result[tile] = distance;
+			}
+		}
+
+		reverseDistanceMap[distance++] = border;
+		remaining = inner;
 	}
 	return result;
 }
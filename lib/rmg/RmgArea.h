@@ -24,6 +24,37 @@ namespace rmg
 	using DistanceMap = std::map<int3, int>;
 	void toAbsolute(Tileset & tiles, const int3 & position);
 	void toRelative(Tileset & tiles, const int3 & position);
+
+	/// Dense set of tiles within bounding box, one bit per tile
+	/// Used for neighbourhood queries that would otherwise hash every neighbour of every tile
+	class DLL_LINKAGE TileBitmap
+	{
+	public:
+		TileBitmap() = default;
+		/// bounding box of tiles extended by margin on each side, so that neighbours of all tiles fit in
+		TileBitmap(const Tileset & tiles, int margin = 1);
+
+		bool contains(const int3 & tile) const;
+		bool empty() const;
+		void clear();
+		void add(const int3 & tile);
+		void erase(const int3 & tile);
+
+		/// tiles with all 8 neighbours present; tiles outside of box are considered missing
+		TileBitmap eroded() const;
+
+	private:
+		using Word = uint64_t;
+		static constexpr int bitsPerWord = 64;
+
+		int3 origin;
+		int3 size;
+		int wordsPerRow = 0;
+		std::vector<Word> words;
+
+		size_t rowIndex(int y, int z) const;
+		std::vector<Word> shiftedRowsX(int shift) const;
+	};
 	
 	class DLL_LINKAGE Area
 	{
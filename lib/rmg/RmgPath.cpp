@@ -10,30 +10,47 @@
 
 #include "StdInc.h"
 #include "RmgPath.h"
-#include <boost/heap/priority_queue.hpp> //A*
 
 VCMI_LIB_NAMESPACE_BEGIN
 
 using namespace rmg;
 
-const std::function<float(const int3 &, const int3 &)> Path::DEFAULT_MOVEMENT_FUNCTION =
-[](const int3 & src, const int3 & dst)
-{	
-	return 1.f;
-};
-
-//A* priority queue
-using TDistance = std::pair<int3, float>;
-struct NodeComparer
+void PathScratch::reset(const int3 & bounds)
 {
-	bool operator()(const TDistance & lhs, const TDistance & rhs) const
+	if(bounds.x > size.x || bounds.y > size.y || bounds.z > size.z)
+	{
+		size = int3(std::max(size.x, bounds.x), std::max(size.y, bounds.y), std::max(size.z, bounds.z));
+		nodes.assign(static_cast<size_t>(size.x) * size.y * size.z, Node());
+		generation = 0;
+	}
+
+	if(++generation == 0) //counter wrapped around, old stamps may collide with new ones
 	{
-		return (rhs.second < lhs.second);
+		std::fill(nodes.begin(), nodes.end(), Node());
+		generation = 1;
 	}
-};
-boost::heap::priority_queue<TDistance, boost::heap::compare<NodeComparer>> createPriorityQueue()
+
+	open.clear();
+}
+
+void PathScratch::push(float priority, const int3 & tile)
+{
+	open.push_back({priority, tile});
+	std::push_heap(open.begin(), open.end());
+}
+
+int3 PathScratch::pop()
+{
+	std::pop_heap(open.begin(), open.end());
+	int3 tile = open.back().tile;
+	open.pop_back();
+	return tile;
+}
+
+PathScratch & PathScratch::local()
 {
-	return boost::heap::priority_queue<TDistance, boost::heap::compare<NodeComparer>>();
+	static thread_local PathScratch scratch;
+	return scratch;
 }
 
 Path::Path(const Area & area): dArea(&area)
@@ -62,106 +79,64 @@ Path Path::invalid()
 	return Path({});
 }
 
-Path Path::search(const Tileset & dst, bool straight, std::function<float(const int3 &, const int3 &)> moveCostFunction) const
-{
-	//A* algorithm taken from Wiki http://en.wikipedia.org/wiki/A*_search_algorithm
-	if(!dArea)
-		return Path::invalid();
-	
-	if(dst.empty()) // Skip construction of same area
-		return Path(*dArea);
-
-	auto resultArea = *dArea + dst;
-	Path result(resultArea);
-
-	int3 src = rmg::Area(dst).nearest(dPath);
-	result.connect(src);
-	
-	Tileset closed;    // The set of nodes already evaluated.
-	auto open = createPriorityQueue(); // The set of tentative nodes to be evaluated, initially containing the start node
-	std::map<int3, int3> cameFrom;  // The map of navigated nodes.
-	std::map<int3, float> distances;
-	
-	cameFrom[src] = int3(-1, -1, -1); //first node points to finish condition
-	distances[src] = 0;
-	open.push(std::make_pair(src, 0.f));
-	// Cost from start along best known path.
-	
-	while(!open.empty())
+void Path::prepareSearch(PathScratch & scratch, const Tileset & dst) const
+{
+	int3 bounds;
+	auto extend = [&bounds](const int3 & tile)
+	{
+		bounds = int3(std::max(bounds.x, tile.x + 1), std::max(bounds.y, tile.y + 1), std::max(bounds.z, tile.z + 1));
+	};
+
+	for(const auto & tile : dArea->getTiles())
+		extend(tile);
+	for(const auto & tile : dPath.getTiles())
+		extend(tile);
+	for(const auto & tile : dst)
+		extend(tile);
+
+	scratch.reset(bounds);
+}
+
+void Path::markPathTargets(PathScratch & scratch, int3 & targetMin, int3 & targetMax) const
+{
+	targetMin = int3(std::numeric_limits<si32>::max(), std::numeric_limits<si32>::max(), 0);
+	targetMax = int3(std::numeric_limits<si32>::min(), std::numeric_limits<si32>::min(), 0);
+
+	for(const auto & tile : dPath.getTiles())
 	{
-		auto node = open.top();
-		open.pop();
-		int3 currentNode = node.first;
-		
-		closed.insert(currentNode);
-		
-		if(dPath.contains(currentNode)) //we reached connection, stop
-		{
-			// Trace the path using the saved parent information and return path
-			int3 backTracking = currentNode;
-			while (cameFrom[backTracking].valid())
-			{
-				result.dPath.add(backTracking);
-				backTracking = cameFrom[backTracking];
-			}
-			return result;
-		}
-		else
-		{
-			auto computeTileScore = [&open, &closed, &cameFrom, &currentNode, &distances, &moveCostFunction, &result](const int3& pos) -> void
-			{
-				if(closed.count(pos))
-					return;
-				
-				if(!result.dArea->contains(pos))
-					return;
-				
-				float movementCost = moveCostFunction(currentNode, pos) + currentNode.dist2d(pos);
-				
-				float distance = distances[currentNode] + movementCost; //we prefer to use already free paths
-				int bestDistanceSoFar = std::numeric_limits<int>::max();
-				auto it = distances.find(pos);
-				if(it != distances.end())
-					bestDistanceSoFar = static_cast<int>(it->second);
-				
-				if(distance < bestDistanceSoFar)
-				{
-					cameFrom[pos] = currentNode;
-					open.push(std::make_pair(pos, distance));
-					distances[pos] = distance;
-				}
-			};
-			
-			auto dirs = int3::getDirs();
-			std::vector<int3> neighbors(dirs.begin(), dirs.end());
-			if(straight)
-				neighbors.assign(rmg::dirs4.begin(), rmg::dirs4.end());
-			for(auto & i : neighbors)
-			{
-				computeTileScore(currentNode + i);
-			}
-		}
-		
+		if(!scratch.inBounds(tile))
+			continue;
+
+		scratch.markTarget(scratch[tile]);
+		targetMin = int3(std::min(targetMin.x, tile.x), std::min(targetMin.y, tile.y), 0);
+		targetMax = int3(std::max(targetMax.x, tile.x), std::max(targetMax.y, tile.y), 0);
 	}
-	
-	result.dPath.clear();
-	return result;
 }
 
-Path Path::search(const int3 & dst, bool straight, std::function<float(const int3 &, const int3 &)> moveCostFunction) const
+void Path::tracePath(PathScratch & scratch, const int3 & tile)
 {
-	return search(Tileset{dst}, straight, std::move(moveCostFunction));
+	for(int3 backTracking = tile; backTracking.valid(); backTracking = scratch[backTracking].parent)
+		dPath.add(backTracking);
 }
 
-Path Path::search(const Area & dst, bool straight, std::function<float(const int3 &, const int3 &)> moveCostFunction) const
+boost::iterator_range<const int3 *> Path::neighbours(bool straight)
 {
-	return search(dst.getTiles(), straight, std::move(moveCostFunction));
+	static const auto allDirs = int3::getDirs();
+	if(straight)
+		return boost::make_iterator_range(rmg::dirs4.data(), rmg::dirs4.data() + rmg::dirs4.size());
+
+	return boost::make_iterator_range(allDirs.data(), allDirs.data() + allDirs.size());
 }
 
-Path Path::search(const Path & dst, bool straight, std::function<float(const int3 &, const int3 &)> moveCostFunction) const
+float Path::distanceToBox(const int3 & tile, const int3 & boxMin, const int3 & boxMax)
 {
-	assert(dst.dArea == dArea);
-	return search(dst.dPath, straight, std::move(moveCostFunction));
+	//Euclidean distance to bounding box of targets never overestimates cost of remaining path
+	if(boxMin.x > boxMax.x)
+		return 0.f;
+
+	int dx = std::max({boxMin.x - tile.x, 0, tile.x - boxMax.x});
+	int dy = std::max({boxMin.y - tile.y, 0, tile.y - boxMax.y});
+	return std::sqrt(static_cast<float>(dx * dx + dy * dy));
 }
 
 void Path::connect(const int3 & path)
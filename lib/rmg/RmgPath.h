@@ -18,21 +18,115 @@ VCMI_LIB_NAMESPACE_BEGIN
 
 namespace rmg
 {
-class Path
+/// Scratch grid reused between path searches on the same thread. Nodes are stamped with
+/// a generation counter, so starting a new search does not need to clear the grid
+class DLL_LINKAGE PathScratch
+{
+public:
+	struct Node
+	{
+		uint32_t reached = 0;
+		uint32_t closed = 0;
+		uint32_t target = 0;
+		float distance = 0;
+		int3 parent;
+	};
+
+	struct OpenNode
+	{
+		float priority;
+		int3 tile;
+
+		bool operator<(const OpenNode & other) const
+		{
+			return other.priority < priority;
+		}
+	};
+
+	/// Starts new search over tiles in range [0, bounds)
+	void reset(const int3 & bounds);
+
+	bool inBounds(const int3 & tile) const
+	{
+		return tile.x >= 0 && tile.y >= 0 && tile.z >= 0 && tile.x < size.x && tile.y < size.y && tile.z < size.z;
+	}
+
+	Node & operator[](const int3 & tile)
+	{
+		return nodes[tile.x + size.x * (tile.y + size.y * tile.z)];
+	}
+
+	bool isReached(const Node & node) const { return node.reached == generation; }
+	bool isClosed(const Node & node) const { return node.closed == generation; }
+	bool isTarget(const Node & node) const { return node.target == generation; }
+
+	void reach(Node & node, float distance, const int3 & parent)
+	{
+		node.reached = generation;
+		node.distance = distance;
+		node.parent = parent;
+	}
+	void close(Node & node) { node.closed = generation; }
+	void markTarget(Node & node) { node.target = generation; }
+
+	void push(float priority, const int3 & tile);
+	int3 pop();
+	bool openEmpty() const { return open.empty(); }
+
+	/// Instance owned by calling thread, safe to use from RMG thread pool jobs
+	static PathScratch & local();
+
+private:
+	int3 size;
+	uint32_t generation = 0;
+	std::vector<Node> nodes;
+	std::vector<OpenNode> open;
+};
+
+struct DefaultMovementCost
+{
+	float operator()(const int3 & src, const int3 & dst) const
+	{
+		return 1.f;
+	}
+};
+
+class DLL_LINKAGE Path
 {
 public:
-	const static std::function<float(const int3 &, const int3 &)> DEFAULT_MOVEMENT_FUNCTION;
-	
 	Path(const Area & area);
 	Path(const Area & area, const int3 & src);
 	Path(const Path & path) = default;
 	Path & operator= (const Path & path);
 	bool valid() const;
 	
-	Path search(const Tileset & dst, bool straight, std::function<float(const int3 &, const int3 &)> moveCostFunction = DEFAULT_MOVEMENT_FUNCTION) const;
-	Path search(const int3 & dst, bool straight, std::function<float(const int3 &, const int3 &)> moveCostFunction = DEFAULT_MOVEMENT_FUNCTION) const;
-	Path search(const Area & dst, bool straight, std::function<float(const int3 &, const int3 &)> moveCostFunction = DEFAULT_MOVEMENT_FUNCTION) const;
-	Path search(const Path & dst, bool straight, std::function<float(const int3 &, const int3 &)> moveCostFunction = DEFAULT_MOVEMENT_FUNCTION) const;
+	/// A* search from nearest tile of dst to any tile of this path. Move cost functor
+	/// must be non-negative, it is added on top of euclidean length of every step.
+	/// Tiles with negative coordinates are outside of search grid, path starting at such tile is invalid
+	template<typename MoveCostFunction = DefaultMovementCost>
+	Path search(const Tileset & dst, bool straight, MoveCostFunction && moveCostFunction = {}) const;
+	template<typename MoveCostFunction = DefaultMovementCost>
+	Path search(const int3 & dst, bool straight, MoveCostFunction && moveCostFunction = {}) const
+	{
+		return search(Tileset{dst}, straight, std::forward<MoveCostFunction>(moveCostFunction));
+	}
+	template<typename MoveCostFunction = DefaultMovementCost>
+	Path search(const Area & dst, bool straight, MoveCostFunction && moveCostFunction = {}) const
+	{
+		return search(dst.getTiles(), straight, std::forward<MoveCostFunction>(moveCostFunction));
+	}
+	template<typename MoveCostFunction = DefaultMovementCost>
+	Path search(const Path & dst, bool straight, MoveCostFunction && moveCostFunction = {}) const
+	{
+		assert(dst.dArea == dArea);
+		return search(dst.dPath.getTiles(), straight, std::forward<MoveCostFunction>(moveCostFunction));
+	}
+
+	/// Connects every target to this path using single multi-source search.
+	/// Unlike sequential searches, paths found for earlier targets are not reused by later ones.
+	/// Target tiles with negative coordinates are never reached
+	template<typename MoveCostFunction = DefaultMovementCost>
+	std::vector<Path> searchAll(const std::vector<Tileset> & targets, bool straight, MoveCostFunction && moveCostFunction = {}) const;
 	
 	void connect(const Path & path);
 	void connect(const int3 & path); //TODO: force connection?
@@ -44,10 +138,178 @@ public:
 	static Path invalid();
 	
 private:
-	
+	/// Resets scratch grid to cover all tiles involved in search
+	void prepareSearch(PathScratch & scratch, const Tileset & dst) const;
+	/// Marks tiles of this path as search targets, returns their bounding box
+	void markPathTargets(PathScratch & scratch, int3 & targetMin, int3 & targetMax) const;
+	/// Adds tiles from given one up to start of search
+	void tracePath(PathScratch & scratch, const int3 & tile);
+
+	static boost::iterator_range<const int3 *> neighbours(bool straight);
+	static float distanceToBox(const int3 & tile, const int3 & boxMin, const int3 & boxMax);
+
 	const Area * dArea = nullptr;
 	Area dPath;
 };
+
+template<typename MoveCostFunction>
+Path Path::search(const Tileset & dst, bool straight, MoveCostFunction && moveCostFunction) const
+{
+	if(!dArea)
+		return Path::invalid();
+	
+	if(dst.empty()) // Skip construction of same area
+		return Path(*dArea);
+
+	Path result(*dArea);
+
+	int3 src = rmg::Area(dst).nearest(dPath);
+	result.connect(src);
+
+	auto & scratch = PathScratch::local();
+	int3 targetMin;
+	int3 targetMax;
+	prepareSearch(scratch, dst);
+
+	if(!scratch.inBounds(src))
+		return Path::invalid();
+
+	markPathTargets(scratch, targetMin, targetMax);
+
+	scratch.reach(scratch[src], 0.f, int3(-1, -1, -1));
+	scratch.push(distanceToBox(src, targetMin, targetMax), src);
+
+	while(!scratch.openEmpty())
+	{
+		int3 currentNode = scratch.pop();
+		auto & current = scratch[currentNode];
+		if(scratch.isClosed(current))
+			continue;
+
+		scratch.close(current);
+
+		if(scratch.isTarget(current)) //we reached connection, stop
+		{
+			result.tracePath(scratch, currentNode);
+			return result;
+		}
+
+		for(const auto & dir : neighbours(straight))
+		{
+			int3 pos = currentNode + dir;
+			if(!scratch.inBounds(pos))
+				continue;
+
+			auto & node = scratch[pos];
+			if(scratch.isClosed(node))
+				continue;
+
+			if(!dArea->contains(pos) && !dst.count(pos))
+				continue;
+
+			float distance = current.distance + moveCostFunction(currentNode, pos) + currentNode.dist2d(pos); //we prefer to use already free paths
+			if(!scratch.isReached(node) || distance < node.distance)
+			{
+				scratch.reach(node, distance, currentNode);
+				scratch.push(distance + distanceToBox(pos, targetMin, targetMax), pos);
+			}
+		}
+	}
+
+	result.dPath.clear();
+	return result;
+}
+
+template<typename MoveCostFunction>
+std::vector<Path> Path::searchAll(const std::vector<Tileset> & targets, bool straight, MoveCostFunction && moveCostFunction) const
+{
+	if(!dArea)
+		return std::vector<Path>(targets.size(), Path::invalid());
+
+	std::vector<Path> result(targets.size(), Path(*dArea));
+
+	Tileset allTargets;
+	for(const auto & target : targets)
+		allTargets.insert(target.begin(), target.end());
+
+	if(allTargets.empty())
+		return result;
+
+	auto & scratch = PathScratch::local();
+	prepareSearch(scratch, allTargets);
+
+	// Search runs backwards, from tiles of this path towards targets
+	for(const auto & tile : dPath.getTilesVector())
+	{
+		if(scratch.inBounds(tile) && (dArea->contains(tile) || allTargets.count(tile)))
+		{
+			scratch.reach(scratch[tile], 0.f, int3(-1, -1, -1));
+			scratch.push(0.f, tile);
+		}
+	}
+	for(const auto & tile : allTargets)
+	{
+		if(scratch.inBounds(tile))
+			scratch.markTarget(scratch[tile]);
+	}
+
+	std::vector<bool> resolved(targets.size(), false);
+	size_t remaining = 0;
+	for(size_t i = 0; i < targets.size(); i++)
+	{
+		if(targets[i].empty())
+			resolved[i] = true;
+		else
+			remaining++;
+	}
+
+	while(remaining > 0 && !scratch.openEmpty())
+	{
+		int3 currentNode = scratch.pop();
+		auto & current = scratch[currentNode];
+		if(scratch.isClosed(current))
+			continue;
+
+		scratch.close(current);
+
+		if(scratch.isTarget(current))
+		{
+			for(size_t i = 0; i < targets.size(); i++)
+			{
+				if(resolved[i] || !targets[i].count(currentNode))
+					continue;
+
+				result[i].tracePath(scratch, currentNode);
+				resolved[i] = true;
+				remaining--;
+			}
+		}
+
+		for(const auto & dir : neighbours(straight))
+		{
+			int3 pos = currentNode + dir;
+			if(!scratch.inBounds(pos))
+				continue;
+
+			auto & node = scratch[pos];
+			if(scratch.isClosed(node))
+				continue;
+
+			if(!scratch.isTarget(node) && !dArea->contains(pos))
+				continue;
+
+			// Step is taken from pos towards current node when walking path in normal direction
+			float distance = current.distance + moveCostFunction(pos, currentNode) + currentNode.dist2d(pos);
+			if(!scratch.isReached(node) || distance < node.distance)
+			{
+				scratch.reach(node, distance, currentNode);
+				scratch.push(distance, pos);
+			}
+		}
+	}
+
+	return result;
+}
 }
 
 VCMI_LIB_NAMESPACE_END
@@ -13,7 +13,6 @@
 #include "../Functions.h"
 #include "../CMapGenerator.h"
 #include "../RmgMap.h"
-#include "../../CStopWatch.h"
 #include "../../mapping/CMap.h"
 
 VCMI_LIB_NAMESPACE_BEGIN
@@ -33,6 +32,21 @@ const std::string & Modificator::getName() const
 	return name;
 }
 
+Zone & Modificator::getZone() const
+{
+	return zone;
+}
+
+const std::list<Modificator*> & Modificator::getPreceeders() const
+{
+	return preceeders;
+}
+
+std::chrono::milliseconds Modificator::getProcessTime() const
+{
+	return processTime;
+}
+
 bool Modificator::isReady()
 {
 	Lock lock(mx, boost::try_to_lock);
@@ -74,6 +88,11 @@ bool Modificator::isFinished()
 	}
 }
 
+bool Modificator::hasFailed() const
+{
+	return failed;
+}
+
 void Modificator::run()
 {
 	Lock lock(mx);
@@ -81,7 +100,7 @@ void Modificator::run()
 	if(!finished)
 	{
 		logGlobal->trace("Modificator zone %d - %s - started", zone.getId(), getName());
-		CStopWatch processTime;
+		auto start = std::chrono::steady_clock::now();
 		try
 		{
 			process();
@@ -89,12 +108,14 @@ void Modificator::run()
 		catch(rmgException &e)
 		{
 			logGlobal->error("Modificator %s, exception: %s", getName(), e.what());
+			failed = true;
 		}
 #ifdef RMG_DUMP
 		dump();
 #endif
+		processTime = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
 		finished = true;
-		logGlobal->trace("Modificator zone %d - %s - done (%d ms)", zone.getId(), getName(), processTime.getDiff());
+		logGlobal->trace("Modificator zone %d - %s - done (%d ms)", zone.getId(), getName(), processTime.count());
 	}
 }
 
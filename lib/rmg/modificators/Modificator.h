@@ -46,9 +46,15 @@ public:
 
 	void setName(const std::string & n);
 	const std::string & getName() const;
+	Zone & getZone() const;
+	const std::list<Modificator*> & getPreceeders() const;
+	/// Wall time spent in process(), zero until modificator is finished
+	std::chrono::milliseconds getProcessTime() const;
 
 	bool isReady();
 	bool isFinished();
+	/// True if process() was interrupted by rmgException
+	bool hasFailed() const;
 	
 	void run();
 	void dependency(Modificator * modificator);
@@ -61,6 +67,7 @@ protected:
 	Zone & zone;
 
 	bool finished = false;
+	std::atomic<bool> failed = false;
 	
 	mutable boost::recursive_mutex externalAccessMutex; //Used to communicate between Modificators
 	using RecursiveLock = boost::unique_lock<boost::recursive_mutex>;
@@ -72,6 +79,7 @@ private:
 	std::string name;
 
 	std::list<Modificator*> preceeders; //must be ordered container
+	std::chrono::milliseconds processTime{0};
 
 	mutable boost::shared_mutex mx; //Used only for task scheduling
 
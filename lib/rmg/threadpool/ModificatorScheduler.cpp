@@ -0,0 +1,121 @@
+/*
+ * ModificatorScheduler.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+
+#include "StdInc.h"
+#include "ModificatorScheduler.h"
+#include "../Functions.h"
+#include "../modificators/Modificator.h"
+
+VCMI_LIB_NAMESPACE_BEGIN
+
+ModificatorScheduler::ModificatorScheduler(const TModificators & modificators)
+	: finishedTasks(0)
+{
+	std::map<const Modificator *, Task *> taskByModificator;
+
+	for(const auto & modificator : modificators)
+	{
+		auto task = std::make_unique<Task>();
+		task->index = tasks.size();
+		task->modificator = modificator.get();
+		task->zone = &zones[&modificator->getZone()];
+		task->pendingDependencies = 0;
+
+		taskByModificator[modificator.get()] = task.get();
+		tasks.push_back(std::move(task));
+	}
+
+	for(auto & task : tasks)
+	{
+		for(auto * preceeder : task->modificator->getPreceeders())
+		{
+			auto it = taskByModificator.find(preceeder);
+			if(it == taskByModificator.end())
+			{
+				if(!preceeder->isFinished())
+					logGlobal->error("Modificator %s depends on %s which will never run", task->modificator->getName(), preceeder->getName());
+				continue;
+			}
+
+			it->second->successors.push_back(task.get());
+			task->pendingDependencies++;
+		}
+	}
+}
+
+void ModificatorScheduler::run(size_t concurrency, const std::function<void()> & onFinished)
+{
+	this->onFinished = onFinished;
+
+	tbb::task_arena arena(static_cast<int>(std::max<size_t>(concurrency, 1)));
+	arena.execute([this]()
+	{
+		for(auto & task : tasks)
+		{
+			if(task->pendingDependencies == 0)
+				enqueue(task.get());
+		}
+		group.wait();
+	});
+
+	if(finishedTasks != tasks.size())
+		throw rmgException(boost::str(boost::format("Only %d of %d modificators could run, dependencies are cyclic") % finishedTasks % tasks.size()));
+}
+
+void ModificatorScheduler::enqueue(Task * task)
+{
+	{
+		std::lock_guard<std::mutex> lock(task->zone->mx);
+		if(task->zone->busy)
+		{
+			//Picked up by the zone once its current modificator is done
+			task->zone->ready.insert(task->index);
+			return;
+		}
+		task->zone->busy = true;
+	}
+
+	group.run([this, task]()
+	{
+		execute(task);
+	});
+}
+
+void ModificatorScheduler::execute(Task * task)
+{
+	task->modificator->run();
+	finishedTasks++;
+	onFinished();
+
+	for(auto * successor : task->successors)
+	{
+		if(--successor->pendingDependencies == 0)
+			enqueue(successor);
+	}
+
+	Task * next = nullptr;
+	{
+		std::lock_guard<std::mutex> lock(task->zone->mx);
+		if(task->zone->ready.empty())
+		{
+			task->zone->busy = false;
+			return;
+		}
+		next = tasks[*task->zone->ready.begin()].get();
+		task->zone->ready.erase(task->zone->ready.begin());
+	}
+
+	group.run([this, next]()
+	{
+		execute(next);
+	});
+}
+
+VCMI_LIB_NAMESPACE_END
@@ -0,0 +1,63 @@
+/*
+ * ModificatorScheduler.h, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+
+#pragma once
+
+#include "../Zone.h"
+
+#include <tbb/task_arena.h>
+#include <tbb/task_group.h>
+
+VCMI_LIB_NAMESPACE_BEGIN
+
+class Modificator;
+
+/// Runs modificators of all zones as a dependency graph on TBB work-stealing scheduler.
+/// Modificator is spawned only once all its dependencies are finished, so no worker ever waits for another zone.
+/// Modificators of the same zone never run concurrently
+class DLL_LINKAGE ModificatorScheduler : boost::noncopyable
+{
+public:
+	explicit ModificatorScheduler(const TModificators & modificators);
+
+	/// Blocks until all modificators are finished. Callback is invoked from worker thread after every modificator
+	void run(size_t concurrency, const std::function<void()> & onFinished);
+
+private:
+	struct ZoneQueue;
+
+	struct Task
+	{
+		size_t index;
+		Modificator * modificator;
+		ZoneQueue * zone;
+		std::vector<Task *> successors;
+		std::atomic<size_t> pendingDependencies;
+	};
+
+	struct ZoneQueue
+	{
+		std::mutex mx;
+		bool busy = false;
+		std::set<size_t> ready; //indices of tasks, lowest first to stay close to order of modificators
+	};
+
+	void enqueue(Task * task);
+	void execute(Task * task);
+
+	std::vector<std::unique_ptr<Task>> tasks;
+	std::map<const Zone *, ZoneQueue> zones;
+	std::atomic<size_t> finishedTasks;
+
+	std::function<void()> onFinished;
+	tbb::task_group group;
+};
+
+VCMI_LIB_NAMESPACE_END
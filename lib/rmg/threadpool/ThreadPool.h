@@ -56,11 +56,11 @@ private:
 	mutable BlockingQueue<TRMGfunction> tasks;
 };
 
-ThreadPool::ThreadPool() :
+inline ThreadPool::ThreadPool() :
 	once(BOOST_ONCE_INIT)
 {};
 
-ThreadPool::~ThreadPool()
+inline ThreadPool::~ThreadPool()
 {
 	terminate();
 }
@@ -81,7 +81,7 @@ inline void ThreadPool::init(size_t numThreads)
 	});
 }
 
-bool ThreadPool::isRunning() const
+inline bool ThreadPool::isRunning() const
 {
 	return isInitialized && !stopping && !canceling;
 }
@@ -167,7 +167,7 @@ inline void ThreadPool::cancel()
 	}
 }
 
-auto ThreadPool::async(std::function<void()>&& f) const -> boost::future<void>
+inline auto ThreadPool::async(std::function<void()>&& f) const -> boost::future<void>
 {
 	using TaskT = boost::packaged_task<void>;
 
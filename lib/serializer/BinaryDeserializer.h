@@ -98,8 +98,9 @@ public:
 	Version version;
 
 	std::vector<std::string> loadedStrings;
-	std::map<uint32_t, Serializeable*> loadedPointers;
-	std::map<const Serializeable*, std::shared_ptr<Serializeable>> loadedSharedPointers;
+	/// indexed by pointer id, ids are assigned sequentially by serializer
+	std::vector<Serializeable*> loadedPointers;
+	std::unordered_map<const Serializeable*, std::shared_ptr<Serializeable>> loadedSharedPointers;
 	IGameCallback * cb = nullptr;
 	static constexpr bool trackSerializedPointers = true;
 	static constexpr bool saving = false;
@@ -282,13 +283,12 @@ public:
 		if(trackSerializedPointers)
 		{
 			load( pid ); //get the id
-			auto i = loadedPointers.find(pid); //lookup
 
-			if(i != loadedPointers.end())
+			if(pid < loadedPointers.size() && loadedPointers[pid] != nullptr)
 			{
 				// We already got this pointer
 				// Cast it in case we are loading it to a non-first base pointer
-				data = dynamic_cast<T>(i->second);
+				data = dynamic_cast<T>(loadedPointers[pid]);
 				return;
 			}
 		}
@@ -324,7 +324,14 @@ public:
 	void ptrAllocated(T *ptr, uint32_t pid)
 	{
 		if(trackSerializedPointers && pid != 0xffffffff)
-			loadedPointers[pid] = const_cast<Serializeable*>(dynamic_cast<const Serializeable*>(ptr)); //add loaded pointer to our lookup map; cast is to avoid errors with const T* pt
+		{
+			// new ids always follow already loaded ones, anything else means corrupted data
+			if(pid > loadedPointers.size())
+				throw std::runtime_error("Invalid pointer id " + std::to_string(pid) + " in serialized data!");
+			if(pid == loadedPointers.size())
+				loadedPointers.push_back(nullptr);
+			loadedPointers[pid] = const_cast<Serializeable*>(dynamic_cast<const Serializeable*>(ptr)); //add loaded pointer to our lookup table; cast is to avoid errors with const T* pt
+		}
 	}
 
 	template <typename T>
@@ -84,8 +84,11 @@ class BinarySerializer : public CSaverBase
 public:
 	using Version = ESerializationVersion;
 
-	std::map<std::string, uint32_t> savedStrings;
-	std::map<const Serializeable*, uint32_t> savedPointers;
+	std::unordered_map<std::string, uint32_t> savedStrings;
+	std::unordered_map<const Serializeable*, uint32_t> savedPointers;
+	/// Number of strings saved in compact form. Such strings are encoded relative to all strings saved
+	/// before them, so data that contains them can only be read by receiver of all previous data
+	uint32_t compactStringsSaved = 0;
 
 	Version version = Version::CURRENT;
 	static constexpr bool trackSerializedPointers = true;
@@ -340,6 +343,7 @@ public:
 				return;
 			}
 
+			compactStringsSaved++;
 			auto it = savedStrings.find(data);
 
 			if (it == savedStrings.end())
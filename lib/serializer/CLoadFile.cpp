@@ -9,6 +9,9 @@
  */
 #include "StdInc.h"
 #include "CLoadFile.h"
+#include "CSaveFile.h"
+
+#include <zlib.h>
 
 VCMI_LIB_NAMESPACE_BEGIN
 
@@ -23,16 +26,66 @@ CLoadFile::~CLoadFile() = default;
 
 int CLoadFile::read(std::byte * data, unsigned size)
 {
-	sfile->read(reinterpret_cast<char *>(data), size);
+	if(!compressed)
+	{
+		sfile->read(reinterpret_cast<char *>(data), size);
+		return size;
+	}
+
+	unsigned copied = 0;
+	while(copied < size)
+	{
+		if(chunkPosition == currentChunk.size())
+			readNextChunk();
+
+		size_t toCopy = std::min<size_t>(size - copied, currentChunk.size() - chunkPosition);
+		std::copy_n(currentChunk.data() + chunkPosition, toCopy, data + copied);
+		chunkPosition += toCopy;
+		copied += toCopy;
+	}
 	return size;
 }
 
+void CLoadFile::readNextChunk()
+{
+	std::array<ui32, 2> header;
+	sfile->read(reinterpret_cast<char *>(header.data()), sizeof(header));
+
+	if(serializer.reverseEndianness)
+	{
+		for(auto & value : header)
+		{
+			auto * valuePtr = reinterpret_cast<char *>(&value);
+			std::reverse(valuePtr, valuePtr + sizeof(value));
+		}
+	}
+
+	// sizes come from file, reject them before allocating buffers
+	if(header[0] > CSaveFile::COMPRESSED_CHUNK_SIZE || header[1] > compressBound(CSaveFile::COMPRESSED_CHUNK_SIZE))
+		THROW_FORMAT("Error: corrupted compressed data in %s!", fName);
+
+	uLongf inflatedSize = header[0];
+	std::vector<Bytef> deflated(header[1]);
+	sfile->read(reinterpret_cast<char *>(deflated.data()), deflated.size());
+
+	currentChunk.resize(inflatedSize);
+	int ret = uncompress(reinterpret_cast<Bytef *>(currentChunk.data()), &inflatedSize, deflated.data(), deflated.size());
+	if(ret != Z_OK || inflatedSize != header[0] || inflatedSize == 0)
+		THROW_FORMAT("Error: corrupted compressed data in %s!", fName);
+
+	chunkPosition = 0;
+}
+
 void CLoadFile::openNextFile(const boost::filesystem::path & fname, ESerializationVersion minimalVersion)
 {
 	serializer.loadingGamestate = true;
 	assert(!serializer.reverseEndianness);
 	assert(minimalVersion <= ESerializationVersion::CURRENT);
 
+	compressed = false;
+	currentChunk.clear();
+	chunkPosition = 0;
+
 	try
 	{
 		fName = fname.string();
@@ -45,7 +98,8 @@ void CLoadFile::openNextFile(const boost::filesystem::path & fname, ESerializati
 		//we can read
 		char buffer[4];
 		sfile->read(buffer, 4);
-		if(std::memcmp(buffer, "VCMI", 4) != 0)
+		bool compressedFile = std::memcmp(buffer, "VCMZ", 4) == 0;
+		if(!compressedFile && std::memcmp(buffer, "VCMI", 4) != 0)
 			THROW_FORMAT("Error: not a VCMI file(%s)!", fName);
 
 		serializer & serializer.version;
@@ -68,6 +122,9 @@ void CLoadFile::openNextFile(const boost::filesystem::path & fname, ESerializati
 			else
 				THROW_FORMAT("Error: too new file format (%s)!", fName);
 		}
+
+		// everything past format version is stored in compressed chunks
+		compressed = compressedFile;
 	}
 	catch(...)
 	{
@@ -87,6 +144,10 @@ void CLoadFile::clear()
 {
 	sfile = nullptr;
 	fName.clear();
+	compressed = false;
+	currentChunk.clear();
+	currentChunk.shrink_to_fit();
+	chunkPosition = 0;
 	serializer.version = ESerializationVersion::NONE;
 }
 
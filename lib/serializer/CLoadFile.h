@@ -15,6 +15,12 @@ VCMI_LIB_NAMESPACE_BEGIN
 
 class DLL_LINKAGE CLoadFile : public IBinaryReader
 {
+	/// Decompressed content of current chunk. Used only for compressed saves
+	std::vector<std::byte> currentChunk;
+	size_t chunkPosition = 0;
+	bool compressed = false;
+
+	void readNextChunk(); //throws!
 public:
 	BinaryDeserializer serializer;
 
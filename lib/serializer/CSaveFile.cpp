@@ -9,26 +9,73 @@
  */
 #include "StdInc.h"
 #include "CSaveFile.h"
+#include "../ScopeGuard.h"
+
+#include <zlib.h>
 
 VCMI_LIB_NAMESPACE_BEGIN
 
-CSaveFile::CSaveFile(const boost::filesystem::path &fname)
+CSaveFile::CSaveFile(const boost::filesystem::path &fname, bool compressed)
 	: serializer(this)
 {
-	openNextFile(fname);
+	openNextFile(fname, compressed);
 }
 
-//must be instantiated in .cpp file for access to complete types of all member fields
-CSaveFile::~CSaveFile() = default;
+CSaveFile::~CSaveFile()
+{
+	try
+	{
+		clear();
+	}
+	catch(const std::exception & e)
+	{
+		logGlobal->error("Failed to finish writing %s: %s", fName.string(), e.what());
+	}
+}
 
 int CSaveFile::write(const std::byte * data, unsigned size)
 {
-	sfile->write(reinterpret_cast<const char *>(data), size);
+	if(!compressed)
+	{
+		sfile->write(reinterpret_cast<const char *>(data), size);
+		return size;
+	}
+
+	// large writes are split, so no chunk exceeds limit checked on loading
+	for(unsigned written = 0; written < size;)
+	{
+		size_t toCopy = std::min<size_t>(size - written, COMPRESSED_CHUNK_SIZE - pendingChunk.size());
+		pendingChunk.insert(pendingChunk.end(), data + written, data + written + toCopy);
+		written += toCopy;
+
+		if(pendingChunk.size() == COMPRESSED_CHUNK_SIZE)
+			writeChunk();
+	}
 	return size;
 }
 
-void CSaveFile::openNextFile(const boost::filesystem::path &fname)
+void CSaveFile::writeChunk()
 {
+	if(pendingChunk.empty())
+		return;
+
+	std::vector<Bytef> deflated(compressBound(pendingChunk.size()));
+	uLongf deflatedSize = deflated.size();
+
+	int ret = compress2(deflated.data(), &deflatedSize, reinterpret_cast<const Bytef *>(pendingChunk.data()), pendingChunk.size(), Z_BEST_SPEED);
+	if(ret != Z_OK)
+		THROW_FORMAT("Error: failed to compress data for %s!", fName);
+
+	// chunk header: size of data after decompression and size of compressed data
+	const std::array<ui32, 2> header = { static_cast<ui32>(pendingChunk.size()), static_cast<ui32>(deflatedSize) };
+	sfile->write(reinterpret_cast<const char *>(header.data()), sizeof(header));
+	sfile->write(reinterpret_cast<const char *>(deflated.data()), deflatedSize);
+	pendingChunk.clear();
+}
+
+void CSaveFile::openNextFile(const boost::filesystem::path &fname, bool compressed)
+{
+	clear();
 	fName = fname;
 	try
 	{
@@ -38,8 +85,12 @@ void CSaveFile::openNextFile(const boost::filesystem::path &fname)
 		if(!(*sfile))
 			THROW_FORMAT("Error: cannot open to write %s!", fname);
 
-		sfile->write("VCMI",4); //write magic identifier
+		sfile->write(compressed ? "VCMZ" : "VCMI", 4); //write magic identifier
 		serializer & ESerializationVersion::CURRENT; //write format version
+
+		this->compressed = compressed;
+		if(compressed)
+			pendingChunk.reserve(COMPRESSED_CHUNK_SIZE);
 	}
 	catch(...)
 	{
@@ -60,8 +111,21 @@ void CSaveFile::reportState(vstd::CLoggerBase * out)
 
 void CSaveFile::clear()
 {
-	fName.clear();
-	sfile = nullptr;
+	// file is closed even if writing fails, so destructor does not attempt to write it again
+	auto closeFile = vstd::makeScopeGuard([this]()
+	{
+		compressed = false;
+		pendingChunk.clear();
+		pendingChunk.shrink_to_fit();
+		fName.clear();
+		sfile = nullptr;
+	});
+
+	if(compressed && sfile)
+		writeChunk();
+
+	if(sfile)
+		sfile->flush();
 }
 
 void CSaveFile::putMagicBytes(const std::string &text)
@@ -69,4 +133,37 @@ void CSaveFile::putMagicBytes(const std::string &text)
 	write(reinterpret_cast<const std::byte*>(text.c_str()), text.length());
 }
 
+CSaveSnapshot::CSaveSnapshot()
+	: serializer(this)
+{
+}
+
+int CSaveSnapshot::write(const std::byte * data, unsigned size)
+{
+	buffer.insert(buffer.end(), data, data + size);
+	return size;
+}
+
+void CSaveSnapshot::putMagicBytes(const std::string &text)
+{
+	write(reinterpret_cast<const std::byte*>(text.c_str()), text.length());
+}
+
+size_t CSaveSnapshot::size() const
+{
+	return buffer.size();
+}
+
+void CSaveSnapshot::writeToFile(const boost::filesystem::path &fname, bool compressed) const
+{
+	CSaveFile file(fname, compressed);
+
+	// passed in pieces, since size of single write is limited to 32 bits
+	for(size_t offset = 0; offset < buffer.size(); offset += CSaveFile::COMPRESSED_CHUNK_SIZE)
+		file.write(buffer.data() + offset, std::min(CSaveFile::COMPRESSED_CHUNK_SIZE, buffer.size() - offset));
+
+	// unlike destructor, reports failure to write last chunk
+	file.clear();
+}
+
 VCMI_LIB_NAMESPACE_END
@@ -15,18 +15,29 @@ VCMI_LIB_NAMESPACE_BEGIN
 
 class DLL_LINKAGE CSaveFile : public IBinaryWriter
 {
+	/// Serialized data that is not yet compressed and written to file. Used only in compressed mode
+	std::vector<std::byte> pendingChunk;
+	bool compressed = false;
+
+	void writeChunk();
 public:
+	/// Maximal amount of serialized data that is deflated at once. Each chunk is compressed independently,
+	/// so loading can decompress one chunk at a time while deserializing it
+	static constexpr size_t COMPRESSED_CHUNK_SIZE = 1024 * 1024;
+
 	BinarySerializer serializer;
 
 	boost::filesystem::path fName;
 	std::unique_ptr<std::fstream> sfile;
 
-	CSaveFile(const boost::filesystem::path &fname); //throws!
+	/// if compressed is set, everything after format version is stored as sequence of independently deflated chunks
+	CSaveFile(const boost::filesystem::path &fname, bool compressed = false); //throws!
 	~CSaveFile();
 	int write(const std::byte * data, unsigned size) override;
 
-	void openNextFile(const boost::filesystem::path &fname); //throws!
-	void clear();
+	void openNextFile(const boost::filesystem::path &fname, bool compressed = false); //throws!
+	/// writes remaining data and closes file. Unlike destructor, reports failure to write
+	void clear(); //throws!
 	void reportState(vstd::CLoggerBase * out) override;
 
 	void putMagicBytes(const std::string &text);
@@ -39,4 +50,30 @@ public:
 	}
 };
 
+/// Save file image kept in memory. Taking snapshot is much faster than saving into file,
+/// compression and disk I/O are performed later by writeToFile, which can run on another thread
+class DLL_LINKAGE CSaveSnapshot : public IBinaryWriter
+{
+	std::vector<std::byte> buffer;
+
+public:
+	BinarySerializer serializer;
+
+	CSaveSnapshot();
+	int write(const std::byte * data, unsigned size) override;
+
+	void putMagicBytes(const std::string &text);
+	size_t size() const;
+
+	/// writes file in CSaveFile format, readable by CLoadFile
+	void writeToFile(const boost::filesystem::path &fname, bool compressed) const; //throws!
+
+	template<class T>
+	CSaveSnapshot & operator<<(const T &t)
+	{
+		serializer & t;
+		return * this;
+	}
+};
+
 VCMI_LIB_NAMESPACE_END
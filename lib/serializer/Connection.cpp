@@ -16,13 +16,14 @@
 #include "../gameState/CGameState.h"
 #include "../networkPacks/NetPacksBase.h"
 #include "../network/NetworkInterface.h"
+#include "../network/NetworkPacketPool.h"
 
 VCMI_LIB_NAMESPACE_BEGIN
 
 class DLL_LINKAGE ConnectionPackWriter final : public IBinaryWriter
 {
 public:
-	std::vector<std::byte> buffer;
+	std::shared_ptr<std::vector<std::byte>> buffer;
 
 	int write(const std::byte * data, unsigned size) final;
 };
@@ -38,7 +39,7 @@ public:
 
 int ConnectionPackWriter::write(const std::byte * data, unsigned size)
 {
-	buffer.insert(buffer.end(), data, data + size);
+	buffer->insert(buffer->end(), data, data + size);
 	return size;
 }
 
@@ -56,6 +57,7 @@ CConnection::CConnection(std::weak_ptr<INetworkConnection> networkConnection)
 	: networkConnection(networkConnection)
 	, packReader(std::make_unique<ConnectionPackReader>())
 	, packWriter(std::make_unique<ConnectionPackWriter>())
+	, packetPool(std::make_shared<NetworkPacketPool>())
 	, deserializer(std::make_unique<BinaryDeserializer>(packReader.get()))
 	, serializer(std::make_unique<BinarySerializer>(packWriter.get()))
 	, connectionID(-1)
@@ -69,6 +71,12 @@ CConnection::CConnection(std::weak_ptr<INetworkConnection> networkConnection)
 CConnection::~CConnection() = default;
 
 void CConnection::sendPack(const CPack & pack)
+{
+	bool connectionIndependent;
+	sendPack(pack, connectionIndependent);
+}
+
+NetworkPacket CConnection::sendPack(const CPack & pack, bool & connectionIndependent)
 {
 	boost::mutex::scoped_lock lock(writeMutex);
 
@@ -77,14 +85,63 @@ void CConnection::sendPack(const CPack & pack)
 	if (!connectionPtr)
 		throw std::runtime_error("Attempt to send packet on a closed connection!");
 
-	packWriter->buffer.clear();
+	// pack is serialized directly into buffer that is handed over to network connection
+	packWriter->buffer = packetPool->acquire();
+	serializer->compactStringsSaved = 0;
 	(*serializer) & (&pack);
+	connectionIndependent = serializer->compactStringsSaved == 0;
 
 	logNetwork->trace("Sending a pack of type %s", typeid(pack).name());
 
-	connectionPtr->sendPacket(packWriter->buffer);
-	packWriter->buffer.clear();
+	NetworkPacket packet = std::move(packWriter->buffer);
+	connectionPtr->sendPacket(packet);
 	serializer->savedPointers.clear();
+	return packet;
+}
+
+void CConnection::sendPacket(const NetworkPacket & packet)
+{
+	boost::mutex::scoped_lock lock(writeMutex);
+
+	auto connectionPtr = networkConnection.lock();
+
+	if (!connectionPtr)
+		throw std::runtime_error("Attempt to send packet on a closed connection!");
+
+	connectionPtr->sendPacket(packet);
+}
+
+bool CConnection::hasSameEncoding(const CConnection & other) const
+{
+	return serializer->version == other.serializer->version
+		&& packWriter->smartVectorMembersSerialization == other.packWriter->smartVectorMembersSerialization
+		&& packWriter->sendStackInstanceByIds == other.packWriter->sendStackInstanceByIds;
+}
+
+void CConnection::sendPackToAll(const CPack & pack, const std::vector<std::shared_ptr<CConnection>> & connections)
+{
+	// connections whose settings match already encoded packet receive the very same buffer
+	std::vector<std::pair<const CConnection *, NetworkPacket>> encodedPackets;
+
+	for(const auto & connection : connections)
+	{
+		auto encoded = boost::range::find_if(encodedPackets, [&connection](const auto & entry)
+		{
+			return entry.first->hasSameEncoding(*connection);
+		});
+
+		if(encoded != encodedPackets.end())
+		{
+			connection->sendPacket(encoded->second);
+			continue;
+		}
+
+		bool connectionIndependent;
+		auto packet = connection->sendPack(pack, connectionIndependent);
+
+		if(connectionIndependent)
+			encodedPackets.emplace_back(connection.get(), packet);
+	}
 }
 
 std::unique_ptr<CPack> CConnection::retrievePack(const std::vector<std::byte> & data)
@@ -9,6 +9,8 @@
  */
 #pragma once
 
+#include "../network/NetworkInterface.h"
+
 enum class ESerializationVersion : int32_t;
 
 VCMI_LIB_NAMESPACE_BEGIN
@@ -19,6 +21,7 @@ struct CPack;
 class INetworkConnection;
 class ConnectionPackReader;
 class ConnectionPackWriter;
+class NetworkPacketPool;
 class CGameState;
 class IGameCallback;
 
@@ -31,11 +34,17 @@ class DLL_LINKAGE CConnection : boost::noncopyable
 
 	std::unique_ptr<ConnectionPackReader> packReader;
 	std::unique_ptr<ConnectionPackWriter> packWriter;
+	std::shared_ptr<NetworkPacketPool> packetPool;
 	std::unique_ptr<BinaryDeserializer> deserializer;
 	std::unique_ptr<BinarySerializer> serializer;
 
 	boost::mutex writeMutex;
 
+	/// Serializes and sends pack, reports whether same data can be sent over other connections with same encoding
+	NetworkPacket sendPack(const CPack & pack, bool & connectionIndependent);
+	void sendPacket(const NetworkPacket & packet);
+	bool hasSameEncoding(const CConnection & other) const;
+
 	void disableStackSendingByID();
 	void enableStackSendingByID();
 	void disableSmartVectorMemberSerialization();
@@ -52,6 +61,9 @@ public:
 	~CConnection();
 
 	void sendPack(const CPack & pack);
+	/// Sends pack to all connections. Pack is serialized once per group of connections with same
+	/// serialization settings, unless its encoding depends on data previously sent over connection
+	static void sendPackToAll(const CPack & pack, const std::vector<std::shared_ptr<CConnection>> & connections);
 	std::unique_ptr<CPack> retrievePack(const std::vector<std::byte> & data);
 
 	void enterLobbyConnectionMode();
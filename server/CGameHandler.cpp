@@ -377,7 +377,7 @@ void CGameHandler::giveExperience(const CGHeroInstance * hero, TExpType amountTo
 		scp.which = SetCommanderProperty::EXPERIENCE;
 		scp.amount = amountToGain;
 		sendAndApply(scp);
-		CBonusSystemNode::treeHasChanged();
+		hero->commander->nodeHasChanged();
 	}
 
 	expGiven(hero);
@@ -520,6 +520,7 @@ CGameHandler::CGameHandler(CVCMIServer * lobby)
 
 CGameHandler::~CGameHandler()
 {
+	waitForPendingSave();
 	delete spellEnv;
 	delete gs;
 	gs = nullptr;
@@ -534,13 +535,18 @@ void CGameHandler::reinitScripting()
 }
 
 void CGameHandler::init(StartInfo *si, Load::ProgressAccumulator & progressTracking)
+{
+	CMapService mapService;
+	init(si, progressTracking, mapService);
+}
+
+void CGameHandler::init(StartInfo *si, Load::ProgressAccumulator & progressTracking, const IMapService & mapService)
 {
 	int requestedSeed = settings["server"]["seed"].Integer();
 	if (requestedSeed != 0)
 		randomNumberGenerator->setSeed(requestedSeed);
 	logGlobal->info("Using random seed: %d", randomNumberGenerator->nextInt());
 
-	CMapService mapService;
 	gs = new CGameState();
 	gs->preInit(VLC, this);
 	logGlobal->info("Gamestate created!");
@@ -1436,9 +1442,11 @@ void CGameHandler::heroExchange(ObjectInstanceID hero1, ObjectInstanceID hero2)
 
 void CGameHandler::sendToAllClients(CPackForClient & pack)
 {
+	if(!lobby)
+		return;
+
 	logNetwork->trace("\tSending to all clients: %s", typeid(pack).name());
-	for (auto c : lobby->activeConnections)
-		c->sendPack(pack);
+	CConnection::sendPackToAll(pack, lobby->activeConnections);
 }
 
 void CGameHandler::sendAndApply(CPackForClient & pack)
@@ -1533,15 +1541,43 @@ void CGameHandler::save(const std::string & filename)
 	ResourcePath savePath(stem.to_string(), EResType::SAVEGAME);
 	CResourceHandler::get("local")->createResource(savefname);
 
+	const auto fileName = *CResourceHandler::get("local")->getResourceName(savePath);
+	const bool compressed = settings["server"]["compressSaves"].Bool();
+
 	try
 	{
+		auto snapshotStart = std::chrono::steady_clock::now();
+		auto snapshot = std::make_shared<CSaveSnapshot>();
+		saveCommonState(*snapshot);
+		logGlobal->info("Saving server state");
+		*snapshot << *this;
+
+		auto snapshotTime = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - snapshotStart);
+		logGlobal->info("Game state snapshot of %d bytes taken in %d ms", snapshot->size(), snapshotTime.count());
+
+		auto writeSnapshot = [snapshot, fileName, compressed]()
 		{
-			CSaveFile save(*CResourceHandler::get("local")->getResourceName(savePath));
-			saveCommonState(save);
-			logGlobal->info("Saving server state");
-			save << *this;
-		}
-		logGlobal->info("Game has been successfully saved!");
+			try
+			{
+				auto writeStart = std::chrono::steady_clock::now();
+				snapshot->writeToFile(fileName, compressed);
+
+				auto writeTime = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - writeStart);
+				logGlobal->info("Game has been successfully saved! Written in %d ms", writeTime.count());
+			}
+			catch(std::exception &e)
+			{
+				logGlobal->error("Failed to save game: %s", e.what());
+			}
+		};
+
+		// previous save may target the same file, so writes are never performed concurrently
+		waitForPendingSave();
+
+		if(settings["server"]["backgroundSaves"].Bool())
+			pendingSave = std::async(std::launch::async, writeSnapshot);
+		else
+			writeSnapshot();
 	}
 	catch(std::exception &e)
 	{
@@ -1549,11 +1585,18 @@ void CGameHandler::save(const std::string & filename)
 	}
 }
 
+void CGameHandler::waitForPendingSave()
+{
+	if(pendingSave.valid())
+		pendingSave.get();
+}
+
 bool CGameHandler::load(const std::string & filename)
 {
 	logGlobal->info("Loading from %s", filename);
 	const auto stem	= FileInfo::GetPathStem(filename);
 
+	waitForPendingSave();
 	reinitScripting();
 
 	try
@@ -17,6 +17,8 @@
 #include "../lib/gameState/GameStatistics.h"
 #include "../lib/networkPacks/PacksForServer.h"
 
+#include <future>
+
 VCMI_LIB_NAMESPACE_BEGIN
 
 struct SideInBattle;
@@ -26,6 +28,7 @@ class CConnection;
 class CCommanderInstance;
 class EVictoryLossCheckResult;
 class CRandomGenerator;
+class IMapService;
 
 struct CPackForServer;
 struct NewTurn;
@@ -100,6 +103,7 @@ public:
 	void createHole(const int3 & visitablePosition, PlayerColor initiator);
 	void newObject(CGObjectInstance * object, PlayerColor initiator);
 
+	/// lobby may be null for game handler without any connected clients, e.g. in battle simulator
 	explicit CGameHandler(CVCMIServer * lobby);
 	~CGameHandler();
 
@@ -193,6 +197,7 @@ public:
 	//////////////////////////////////////////////////////////////////////////
 
 	void init(StartInfo *si, Load::ProgressAccumulator & progressTracking);
+	void init(StartInfo *si, Load::ProgressAccumulator & progressTracking, const IMapService & mapService);
 	void handleClientDisconnection(std::shared_ptr<CConnection> c);
 	void handleReceivedPack(CPackForServer & pack);
 	bool hasPlayerAt(PlayerColor player, std::shared_ptr<CConnection> c) const;
@@ -226,8 +231,10 @@ public:
 	bool bulkSplitStack(SlotID src, ObjectInstanceID srcOwner, si32 howMany);
 	bool bulkMergeStacks(SlotID slotSrc, ObjectInstanceID srcOwner);
 	bool bulkSmartSplitStack(SlotID slotSrc, ObjectInstanceID srcOwner);
+	/// takes snapshot of game state, file is written on background thread if enabled in settings
 	void save(const std::string &fname);
 	bool load(const std::string &fname);
+	void waitForPendingSave();
 
 	void onPlayerTurnStarted(PlayerColor which);
 	void onPlayerTurnEnded(PlayerColor which);
@@ -300,6 +307,8 @@ public:
 	friend class CVCMIServer;
 private:
 	std::unique_ptr<events::EventBus> serverEventBus;
+	/// file write of last save, if it runs in background
+	std::future<void> pendingSave;
 #if SCRIPTING_ENABLED
 	std::shared_ptr<scripting::PoolImpl> serverScripts;
 #endif
@@ -121,37 +121,38 @@ bool TurnOrderProcessor::playersInContact(PlayerColor left, PlayerColor right) c
 		}
 	}
 
-	for(const auto & hero : leftInfo->getHeroes())
+	auto markReachableTiles = [this, &mapSize](const std::vector<const CGHeroInstance *> & heroes, boost::multi_array<bool, 3> & reachability)
 	{
-		CPathsInfo out(mapSize, hero);
-		auto config = std::make_shared<SingleHeroPathfinderConfig>(out, gameHandler->gameState(), hero);
-		config->options.ignoreGuards = true;
-		config->options.turnLimit = 1;
-		CPathfinder pathfinder(gameHandler->gameState(), config);
-		pathfinder.calculatePaths();
-
-		for (int z = 0; z < mapSize.z; ++z)
-			for (int y = 0; y < mapSize.y; ++y)
-				for (int x = 0; x < mapSize.x; ++x)
-					if (out.getNode({x,y,z})->reachable())
-						leftReachability[z][x][y] = true;
-	}
+		// Heroes of one player share accessibility evaluation, chunks keep only few path storages alive at once
+		const size_t chunkSize = CPathfinder::MAX_BATCH_SIZE;
 
-	for(const auto & hero : rightInfo->getHeroes())
-	{
-		CPathsInfo out(mapSize, hero);
-		auto config = std::make_shared<SingleHeroPathfinderConfig>(out, gameHandler->gameState(), hero);
-		config->options.ignoreGuards = true;
-		config->options.turnLimit = 1;
-		CPathfinder pathfinder(gameHandler->gameState(), config);
-		pathfinder.calculatePaths();
-
-		for (int z = 0; z < mapSize.z; ++z)
-			for (int y = 0; y < mapSize.y; ++y)
-				for (int x = 0; x < mapSize.x; ++x)
-					if (out.getNode({x,y,z})->reachable())
-						rightReachability[z][x][y] = true;
-	}
+		for(size_t chunkStart = 0; chunkStart < heroes.size(); chunkStart += chunkSize)
+		{
+			std::vector<std::unique_ptr<CPathsInfo>> paths;
+			std::vector<std::shared_ptr<SingleHeroPathfinderConfig>> configs;
+
+			for(size_t i = chunkStart; i < std::min(heroes.size(), chunkStart + chunkSize); ++i)
+			{
+				paths.push_back(std::make_unique<CPathsInfo>(mapSize, heroes[i]));
+				auto config = std::make_shared<SingleHeroPathfinderConfig>(*paths.back(), gameHandler->gameState(), heroes[i]);
+				config->options.ignoreGuards = true;
+				config->options.turnLimit = 1;
+				configs.push_back(config);
+			}
+
+			CPathfinder::calculatePaths(gameHandler->gameState(), configs);
+
+			for(const auto & out : paths)
+				for (int z = 0; z < mapSize.z; ++z)
+					for (int y = 0; y < mapSize.y; ++y)
+						for (int x = 0; x < mapSize.x; ++x)
+							if (out->getNode({x,y,z})->reachable())
+								reachability[z][x][y] = true;
+		}
+	};
+
+	markReachableTiles(leftInfo->getHeroes(), leftReachability);
+	markReachableTiles(rightInfo->getHeroes(), rightReachability);
 
 	for (int z = 0; z < mapSize.z; ++z)
 		for (int y = 0; y < mapSize.y; ++y)
@@ -258,7 +259,8 @@ void TurnOrderProcessor::doStartNewDay()
 
 	if(!activePlayer)
 	{
-		gameHandler->gameLobby()->setState(EServerState::SHUTDOWN);
+		if(gameHandler->gameLobby())
+			gameHandler->gameLobby()->setState(EServerState::SHUTDOWN);
 		return;
 	}
 
@@ -144,6 +144,8 @@ public:
 	public:
 
 		const IBattleInfo * battle;
+
+		using CBattleInfoCallback::makeBFS;
 #if SCRIPTING_ENABLED
 		scripting::Pool * pool;
 
@@ -685,3 +687,128 @@ TEST_F(BattleMatchOwnerTest, hypnotizedToHypnotizedEnemy)
 	EXPECT_TRUE(subject.battleMatchOwner(&unit1, &unit2, boost::logic::indeterminate));
 	EXPECT_FALSE(subject.battleMatchOwner(&unit1, &unit2, false));
 }
+
+class ReachabilityTest : public CBattleInfoCallbackTest
+{
+public:
+	ReachabilityInfo::Parameters params;
+
+	ReachabilityTest()
+	{
+		params.side = BattleSide::ATTACKER;
+		params.startPosition = BattleHex(2, 5);
+		params.knownAccessible = {params.startPosition};
+	}
+
+	AccessibilityInfo makeAccessibility(const std::vector<BattleHex> & stackHexes)
+	{
+		AccessibilityInfo ret;
+		ret.fill(EAccessibility::ACCESSIBLE);
+
+		for(int y = 0; y < GameConstants::BFIELD_HEIGHT; y++)
+		{
+			ret[BattleHex(GameConstants::BFIELD_WIDTH - 1, y)] = EAccessibility::SIDE_COLUMN;
+			ret[BattleHex(0, y)] = EAccessibility::SIDE_COLUMN;
+		}
+
+		for(auto hex : stackHexes)
+			ret[hex] = EAccessibility::ALIVE_STACK;
+
+		return ret;
+	}
+
+	void expectUpdateMatchesFullBFS(const std::vector<BattleHex> & before, const std::vector<BattleHex> & vacated, const std::vector<BattleHex> & occupied)
+	{
+		startBattle();
+
+		auto after = before;
+		vstd::erase_if(after, [&](BattleHex hex){ return vstd::contains(vacated, hex); });
+		vstd::concatenate(after, occupied);
+
+		auto previous = subject.makeBFS(makeAccessibility(before), params);
+		auto updated = subject.updateReachability(previous, vacated, occupied);
+		auto expected = subject.makeBFS(makeAccessibility(after), params);
+
+		EXPECT_EQ(updated.accessibility, expected.accessibility);
+		EXPECT_EQ(updated.distances, expected.distances);
+
+		for(BattleHex hex = 0; hex < GameConstants::BFIELD_SIZE; hex = hex + 1)
+		{
+			if(hex == params.startPosition || !updated.isReachable(hex))
+				continue;
+
+			auto predecessor = updated.predecessors[hex];
+
+			ASSERT_TRUE(predecessor.isValid());
+			EXPECT_EQ(updated.distances[predecessor] + 1, updated.distances[hex]);
+			EXPECT_EQ(BattleHex::getDistance(predecessor, hex), 1);
+		}
+	}
+};
+
+TEST_F(ReachabilityTest, UnitLeavingWallOpensShorterPath)
+{
+	std::vector<BattleHex> wall;
+
+	for(int y = 0; y < GameConstants::BFIELD_HEIGHT; y++)
+		wall.push_back(BattleHex(6, y));
+
+	expectUpdateMatchesFullBFS(wall, {BattleHex(6, 5)}, {BattleHex(10, 2)});
+}
+
+TEST_F(ReachabilityTest, UnitClosingWallCutsPath)
+{
+	std::vector<BattleHex> wall;
+
+	for(int y = 0; y < GameConstants::BFIELD_HEIGHT; y++)
+	{
+		if(y != 7)
+			wall.push_back(BattleHex(6, y));
+	}
+
+	expectUpdateMatchesFullBFS(wall, {BattleHex(12, 3)}, {BattleHex(6, 7)});
+}
+
+TEST_F(ReachabilityTest, DoubleWideUnitDetour)
+{
+	params.doubleWide = true;
+	params.knownAccessible = battle::Unit::getHexes(params.startPosition, true, params.side);
+
+	std::vector<BattleHex> stacks = {BattleHex(5, 4), BattleHex(5, 5), BattleHex(5, 6), BattleHex(9, 1)};
+
+	expectUpdateMatchesFullBFS(stacks, {BattleHex(5, 5)}, {BattleHex(4, 2), BattleHex(5, 2)});
+}
+
+TEST_F(ReachabilityTest, FrontierSearchMatchesQueueSearch)
+{
+	startBattle();
+
+	std::mt19937 rng(42);
+	std::bernoulli_distribution stackDistribution(0.3);
+
+	for(int layout = 0; layout < 20; layout++)
+	{
+		std::vector<BattleHex> stacks;
+
+		for(BattleHex hex = 0; hex < GameConstants::BFIELD_SIZE; hex = hex + 1)
+		{
+			if(hex != params.startPosition && stackDistribution(rng))
+				stacks.push_back(hex);
+		}
+
+		params.doubleWide = layout % 2;
+		params.knownAccessible = battle::Unit::getHexes(params.startPosition, params.doubleWide, params.side);
+
+		auto accessibility = makeAccessibility(stacks);
+
+		// bypassing without any enemy to destroy is ordinary search with step cost of 1
+		auto queueParams = params;
+		queueParams.bypassEnemyStacks = true;
+
+		auto frontierResult = subject.makeBFS(accessibility, params);
+		auto queueResult = subject.makeBFS(accessibility, queueParams);
+
+		EXPECT_EQ(frontierResult.distances, queueResult.distances);
+		EXPECT_EQ(frontierResult.predecessors, queueResult.predecessors);
+	}
+}
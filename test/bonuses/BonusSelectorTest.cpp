@@ -0,0 +1,84 @@
+/*
+ * BonusSelectorTest.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#include "StdInc.h"
+
+#include "../../lib/bonuses/BonusSelector.h"
+
+namespace test
+{
+
+using namespace ::testing;
+
+class BonusSelectorTest : public Test
+{
+protected:
+	Bonus morale = Bonus(BonusDuration::PERMANENT, BonusType::MORALE, BonusSource::ARTIFACT, 1, BonusSourceID(ArtifactID(5)));
+	Bonus luck = Bonus(BonusDuration::PERMANENT, BonusType::LUCK, BonusSource::SPELL_EFFECT, 2, BonusSourceID(SpellID(7)), BonusSubtypeID(), BonusValueType::BASE_NUMBER);
+};
+
+TEST_F(BonusSelectorTest, FieldSelectors)
+{
+	EXPECT_TRUE(Selector::type()(BonusType::MORALE)(&morale));
+	EXPECT_FALSE(Selector::type()(BonusType::MORALE)(&luck));
+
+	EXPECT_TRUE(Selector::sourceTypeSel(BonusSource::SPELL_EFFECT)(&luck));
+	EXPECT_FALSE(Selector::sourceTypeSel(BonusSource::SPELL_EFFECT)(&morale));
+
+	EXPECT_TRUE(Selector::source(BonusSource::ARTIFACT, BonusSourceID(ArtifactID(5)))(&morale));
+	EXPECT_FALSE(Selector::source(BonusSource::ARTIFACT, BonusSourceID(ArtifactID(6)))(&morale));
+
+	EXPECT_TRUE(Selector::valueType(BonusValueType::BASE_NUMBER)(&luck));
+	EXPECT_FALSE(Selector::valueType(BonusValueType::BASE_NUMBER)(&morale));
+}
+
+TEST_F(BonusSelectorTest, AndCombinesFieldsAndFunctors)
+{
+	auto selector = Selector::all
+		.And(Selector::type()(BonusType::LUCK))
+		.And([](const Bonus * b){ return b->val > 1; });
+
+	EXPECT_TRUE(selector(&luck));
+	EXPECT_FALSE(selector(&morale));
+
+	luck.val = 1;
+	EXPECT_FALSE(selector(&luck));
+}
+
+TEST_F(BonusSelectorTest, ConflictingFieldsMatchNothing)
+{
+	auto selector = Selector::type()(BonusType::LUCK).And(Selector::type()(BonusType::MORALE));
+
+	EXPECT_TRUE(selector);
+	EXPECT_FALSE(selector(&luck));
+	EXPECT_FALSE(selector(&morale));
+}
+
+TEST_F(BonusSelectorTest, OrAndNot)
+{
+	auto selector = Selector::none
+		.Or(Selector::type()(BonusType::LUCK))
+		.Or(Selector::type()(BonusType::MORALE));
+
+	EXPECT_TRUE(selector(&luck));
+	EXPECT_TRUE(selector(&morale));
+
+	EXPECT_FALSE(selector.Not()(&luck));
+	EXPECT_TRUE(Selector::type()(BonusType::LUCK).Not()(&morale));
+}
+
+TEST_F(BonusSelectorTest, EmptySelector)
+{
+	EXPECT_FALSE(CSelector(nullptr));
+	EXPECT_TRUE(Selector::all);
+	EXPECT_TRUE(Selector::all(&luck));
+	EXPECT_FALSE(Selector::none(&luck));
+}
+
+}
@@ -0,0 +1,240 @@
+/*
+ * CBonusSystemNodeTest.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#include "StdInc.h"
+
+#include "../../lib/bonuses/CBonusSystemNode.h"
+#include "../../lib/bonuses/Bonus.h"
+
+// Benchmarks require a lot of time, run with --gtest_also_run_disabled_tests --gtest_filter=CBonusSystemNodeBenchmark.*
+
+namespace test
+{
+
+using namespace ::testing;
+
+class CBonusSystemNodeTest : public Test
+{
+public:
+	CBonusSystemNode player;
+	CBonusSystemNode hero;
+	CBonusSystemNode otherHero;
+	CBonusSystemNode stack;
+
+	CBonusSystemNodeTest()
+		: player(CBonusSystemNode::PLAYER),
+		hero(CBonusSystemNode::HERO),
+		otherHero(CBonusSystemNode::HERO),
+		stack(CBonusSystemNode::STACK_INSTANCE)
+	{
+	}
+
+protected:
+	void SetUp() override
+	{
+		hero.attachTo(player);
+		otherHero.attachTo(player);
+		stack.attachTo(hero);
+	}
+
+	static std::shared_ptr<Bonus> makeBonus(BonusType type, int val)
+	{
+		return std::make_shared<Bonus>(BonusDuration::PERMANENT, type, BonusSource::OTHER, val, BonusSourceID());
+	}
+};
+
+TEST_F(CBonusSystemNodeTest, ChangeDoesNotInvalidateUnrelatedNodes)
+{
+	otherHero.addNewBonus(makeBonus(BonusType::MORALE, 1));
+	EXPECT_EQ(otherHero.valOfBonuses(BonusType::MORALE), 1);
+
+	const auto otherVersion = otherHero.getTreeVersion();
+	const auto playerVersion = player.getTreeVersion();
+	const auto heroVersion = hero.getTreeVersion();
+	const auto stackVersion = stack.getTreeVersion();
+
+	hero.addNewBonus(makeBonus(BonusType::MORALE, 2));
+
+	EXPECT_EQ(otherHero.getTreeVersion(), otherVersion);
+	EXPECT_EQ(player.getTreeVersion(), playerVersion);
+	EXPECT_NE(hero.getTreeVersion(), heroVersion);
+	EXPECT_NE(stack.getTreeVersion(), stackVersion);
+
+	EXPECT_EQ(otherHero.valOfBonuses(BonusType::MORALE), 1);
+	EXPECT_EQ(hero.valOfBonuses(BonusType::MORALE), 2);
+	EXPECT_EQ(stack.valOfBonuses(BonusType::MORALE), 2);
+}
+
+TEST_F(CBonusSystemNodeTest, ParentChangeInvalidatesDescendants)
+{
+	EXPECT_EQ(stack.valOfBonuses(BonusType::LUCK), 0);
+	EXPECT_EQ(otherHero.valOfBonuses(BonusType::LUCK), 0);
+
+	auto bonus = makeBonus(BonusType::LUCK, 3);
+	player.addNewBonus(bonus);
+
+	EXPECT_EQ(stack.valOfBonuses(BonusType::LUCK), 3);
+	EXPECT_EQ(otherHero.valOfBonuses(BonusType::LUCK), 3);
+
+	player.removeBonus(bonus);
+
+	EXPECT_EQ(stack.valOfBonuses(BonusType::LUCK), 0);
+	EXPECT_EQ(otherHero.valOfBonuses(BonusType::LUCK), 0);
+}
+
+TEST_F(CBonusSystemNodeTest, DetachInvalidatesDetachedSubtree)
+{
+	player.addNewBonus(makeBonus(BonusType::LUCK, 3));
+	EXPECT_EQ(stack.valOfBonuses(BonusType::LUCK), 3);
+
+	hero.detachFrom(player);
+
+	EXPECT_EQ(hero.valOfBonuses(BonusType::LUCK), 0);
+	EXPECT_EQ(stack.valOfBonuses(BonusType::LUCK), 0);
+	EXPECT_EQ(otherHero.valOfBonuses(BonusType::LUCK), 3);
+}
+
+TEST_F(CBonusSystemNodeTest, HypotheticNodeTracksParentChanges)
+{
+	CBonusSystemNode hypothetic(true);
+	hypothetic.attachTo(hero);
+
+	EXPECT_EQ(hypothetic.valOfBonuses(BonusType::MORALE), 0);
+
+	player.addNewBonus(makeBonus(BonusType::MORALE, 1));
+
+	EXPECT_EQ(hypothetic.valOfBonuses(BonusType::MORALE), 1);
+
+	hypothetic.detachFrom(hero);
+}
+
+TEST_F(CBonusSystemNodeTest, GlobalChangeInvalidatesAllNodes)
+{
+	const auto otherVersion = otherHero.getTreeVersion();
+	const auto stackVersion = stack.getTreeVersion();
+
+	CBonusSystemNode::treeHasChanged();
+
+	EXPECT_NE(otherHero.getTreeVersion(), otherVersion);
+	EXPECT_NE(stack.getTreeVersion(), stackVersion);
+}
+
+TEST_F(CBonusSystemNodeTest, TypeQueriesSelectOnlyBonusesOfThatType)
+{
+	auto luck1 = makeBonus(BonusType::LUCK, 1);
+	auto morale = makeBonus(BonusType::MORALE, 2);
+	auto luck2 = makeBonus(BonusType::LUCK, 4);
+	luck2->source = BonusSource::ARTIFACT;
+
+	player.addNewBonus(luck1);
+	hero.addNewBonus(morale);
+	hero.addNewBonus(luck2);
+
+	auto luckBonuses = stack.getBonuses(Selector::type()(BonusType::LUCK));
+	ASSERT_EQ(luckBonuses->size(), 2);
+	EXPECT_EQ(stack.valOfBonuses(BonusType::LUCK), 5);
+
+	auto allBonuses = stack.getBonuses(Selector::all);
+	BonusList expected;
+	allBonuses->getBonuses(expected, Selector::type()(BonusType::LUCK));
+	EXPECT_EQ((*luckBonuses)[0], expected[0]);
+	EXPECT_EQ((*luckBonuses)[1], expected[1]);
+
+	auto artifactLuck = stack.getBonuses(Selector::type()(BonusType::LUCK).And(Selector::sourceTypeSel(BonusSource::ARTIFACT)));
+	ASSERT_EQ(artifactLuck->size(), 1);
+	EXPECT_EQ((*artifactLuck)[0], luck2);
+
+	EXPECT_FALSE(stack.hasBonusOfType(BonusType::FLYING));
+}
+
+TEST_F(CBonusSystemNodeTest, RecalculationsAreCounted)
+{
+	EXPECT_EQ(stack.valOfBonuses(BonusType::LUCK), 0);
+	const auto recalculated = CBonusSystemNode::getBonusesRecalculatedCount();
+
+	EXPECT_EQ(stack.valOfBonuses(BonusType::LUCK), 0);
+	EXPECT_EQ(CBonusSystemNode::getBonusesRecalculatedCount(), recalculated);
+
+	hero.addNewBonus(makeBonus(BonusType::LUCK, 1));
+	EXPECT_EQ(stack.valOfBonuses(BonusType::LUCK), 1);
+	EXPECT_EQ(CBonusSystemNode::getBonusesRecalculatedCount(), recalculated + 1);
+}
+
+/// Bonus tree shaped like one of large game: players, their heroes and stacks of these heroes
+class BenchmarkBonusTree
+{
+public:
+	std::vector<std::unique_ptr<CBonusSystemNode>> nodes;
+	std::vector<CBonusSystemNode *> heroes;
+
+	BenchmarkBonusTree(int players, int heroesPerPlayer, int stacksPerHero)
+	{
+		for(int p = 0; p < players; ++p)
+		{
+			auto * player = add(CBonusSystemNode::PLAYER, nullptr);
+			for(int h = 0; h < heroesPerPlayer; ++h)
+			{
+				auto * hero = add(CBonusSystemNode::HERO, player);
+				heroes.push_back(hero);
+				for(int s = 0; s < stacksPerHero; ++s)
+					add(CBonusSystemNode::STACK_INSTANCE, hero);
+			}
+		}
+	}
+
+	~BenchmarkBonusTree()
+	{
+		// children must be detached before their parents are destroyed
+		while(!nodes.empty())
+			nodes.pop_back();
+	}
+
+	void queryAll() const
+	{
+		for(const auto & node : nodes)
+			node->valOfBonuses(BonusType::PRIMARY_SKILL);
+	}
+
+private:
+	CBonusSystemNode * add(CBonusSystemNode::ENodeTypes type, CBonusSystemNode * parent)
+	{
+		nodes.push_back(std::make_unique<CBonusSystemNode>(type));
+		nodes.back()->addNewBonus(std::make_shared<Bonus>(BonusDuration::PERMANENT, BonusType::PRIMARY_SKILL, BonusSource::OTHER, 1, BonusSourceID()));
+		if(parent)
+			nodes.back()->attachTo(*parent);
+		return nodes.back().get();
+	}
+};
+
+/// Emulates AI turn: every hero gets bonus from visited object while bonuses of all nodes are queried after each change.
+/// Global invalidation, used before per-node versions, is emulated with treeHasChanged after each change
+TEST(CBonusSystemNodeBenchmark, DISABLED_RecalculationsPerTurn)
+{
+	for(bool globalInvalidation : {true, false})
+	{
+		BenchmarkBonusTree tree(8, 8, 7);
+		tree.queryAll();
+
+		const auto recalculated = CBonusSystemNode::getBonusesRecalculatedCount();
+		auto start = std::chrono::steady_clock::now();
+
+		for(auto * hero : tree.heroes)
+		{
+			hero->addNewBonus(std::make_shared<Bonus>(BonusDuration::ONE_DAY, BonusType::MORALE, BonusSource::OBJECT_INSTANCE, 1, BonusSourceID()));
+			if(globalInvalidation)
+				CBonusSystemNode::treeHasChanged();
+			tree.queryAll();
+		}
+
+		auto time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		logGlobal->info("Bonus system benchmark, %s invalidation: %d recalculations, %.3f s", globalInvalidation ? "global" : "per node", CBonusSystemNode::getBonusesRecalculatedCount() - recalculated, time);
+	}
+}
+
+}
@@ -31,6 +31,10 @@
 
 #include "../../lib/mapping/CMap.h"
 
+#include "../../lib/pathfinder/CGPathNode.h"
+#include "../../lib/pathfinder/CPathfinder.h"
+#include "../../lib/pathfinder/PathfinderOptions.h"
+
 #include "../../lib/spells/CSpellHandler.h"
 #include "../../lib/spells/ISpellMechanics.h"
 #include "../../lib/spells/AbilityCaster.h"
@@ -401,3 +405,50 @@ TEST_F(CGameStateTest, DISABLED_battleResurrection)
 	EXPECT_EQ(unit->health.getCount(), 10);
 	EXPECT_EQ(unit->health.getResurrected(), 0);
 }
+
+TEST_F(CGameStateTest, DISABLED_batchedPathfindingMatchesSequential)
+{
+	startTestGame();
+
+	const int3 mapSize = gameState->getMapSize();
+	std::vector<std::unique_ptr<CPathsInfo>> sequential;
+	std::vector<std::unique_ptr<CPathsInfo>> batched;
+	std::vector<std::shared_ptr<SingleHeroPathfinderConfig>> configs;
+
+	for(const CGHeroInstance * hero : map->heroesOnMap)
+	{
+		sequential.push_back(std::make_unique<CPathsInfo>(mapSize, hero));
+		gameState->calculatePaths(hero, *sequential.back());
+
+		batched.push_back(std::make_unique<CPathsInfo>(mapSize, hero));
+		configs.push_back(std::make_shared<SingleHeroPathfinderConfig>(*batched.back(), gameState.get(), hero));
+	}
+
+	CPathfinder::calculatePaths(gameState.get(), configs);
+
+	for(size_t i = 0; i < sequential.size(); i++)
+	{
+		int3 pos;
+		for(pos.z = 0; pos.z < mapSize.z; pos.z++)
+		for(pos.x = 0; pos.x < mapSize.x; pos.x++)
+		for(pos.y = 0; pos.y < mapSize.y; pos.y++)
+		{
+			for(EPathfindingLayer layer = EPathfindingLayer::LAND; layer < EPathfindingLayer::NUM_LAYERS; layer.advance(1))
+			{
+				const CGPathNode * expected = sequential[i]->getNode(pos, layer);
+				const CGPathNode * actual = batched[i]->getNode(pos, layer);
+
+				EXPECT_EQ(actual->accessible, expected->accessible) << pos.toString();
+				EXPECT_EQ(actual->action, expected->action) << pos.toString();
+				EXPECT_EQ(actual->turns, expected->turns) << pos.toString();
+				EXPECT_EQ(actual->moveRemains, expected->moveRemains) << pos.toString();
+				EXPECT_EQ(actual->theNodeBefore == nullptr, expected->theNodeBefore == nullptr) << pos.toString();
+
+				if(actual->theNodeBefore && expected->theNodeBefore)
+				{
+					EXPECT_EQ(actual->theNodeBefore->coord, expected->theNodeBefore->coord) << pos.toString();
+				}
+			}
+		}
+	}
+}
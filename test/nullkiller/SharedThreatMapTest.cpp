@@ -0,0 +1,132 @@
+/*
+ * SharedThreatMapTest.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#include "StdInc.h"
+
+#include "../../AI/Nullkiller/Analyzers/SharedThreatMap.h"
+
+namespace test
+{
+using namespace ::testing;
+using namespace ::NKAI;
+
+class SharedThreatMapTest : public Test
+{
+public:
+	int calculations = 0;
+
+	SharedThreatMap::Calculator calculator()
+	{
+		return [this]()
+		{
+			calculations++;
+			return std::make_shared<EnemyThreatMap>();
+		};
+	}
+
+	static SharedThreatMap::Key key(TeamID team, size_t enemyHeroes = 1, uint64_t gameState = 1)
+	{
+		SharedThreatMap::Key result;
+
+		result.gameState = gameState;
+		result.team = team;
+		result.enemy = PlayerColor(2);
+		result.turnLimit = 255;
+		result.visibility = 1;
+		result.enemyHeroes = enemyHeroes;
+		result.objects = 1;
+
+		return result;
+	}
+
+	void SetUp() override
+	{
+		SharedThreatMap::clear();
+	}
+
+	void TearDown() override
+	{
+		SharedThreatMap::clear();
+	}
+};
+
+TEST_F(SharedThreatMapTest, SharesEntryWithinTeam)
+{
+	// two AIs of the same team observing the same enemy state
+	auto redThreats = SharedThreatMap::get(key(TeamID(0)), calculator());
+	auto blueThreats = SharedThreatMap::get(key(TeamID(0)), calculator());
+
+	EXPECT_EQ(calculations, 1);
+	EXPECT_EQ(redThreats, blueThreats);
+	EXPECT_EQ(SharedThreatMap::size(), 1);
+}
+
+TEST_F(SharedThreatMapTest, HitsCacheOfEachTeam)
+{
+	auto first = key(TeamID(0));
+	auto second = key(TeamID(1));
+
+	auto firstThreats = SharedThreatMap::get(first, calculator());
+	auto secondThreats = SharedThreatMap::get(second, calculator());
+
+	// objects of own team are not dangerous, so teams see different threats of the same enemy
+	EXPECT_EQ(calculations, 2);
+	EXPECT_NE(firstThreats, secondThreats);
+
+	EXPECT_EQ(SharedThreatMap::get(first, calculator()), firstThreats);
+	EXPECT_EQ(SharedThreatMap::get(second, calculator()), secondThreats);
+	EXPECT_EQ(calculations, 2);
+	EXPECT_EQ(SharedThreatMap::size(), 2);
+}
+
+TEST_F(SharedThreatMapTest, ChangedEnemyReplacesEntryOfTeamOnly)
+{
+	auto first = key(TeamID(0));
+	auto second = key(TeamID(1));
+	auto firstMoved = key(TeamID(0), 2);
+
+	SharedThreatMap::get(first, calculator());
+	auto secondThreats = SharedThreatMap::get(second, calculator());
+	auto firstMovedThreats = SharedThreatMap::get(firstMoved, calculator());
+
+	EXPECT_EQ(calculations, 3);
+	EXPECT_EQ(SharedThreatMap::size(), 2);
+
+	EXPECT_EQ(SharedThreatMap::get(firstMoved, calculator()), firstMovedThreats);
+	EXPECT_EQ(SharedThreatMap::get(second, calculator()), secondThreats);
+	EXPECT_EQ(calculations, 3);
+}
+
+TEST_F(SharedThreatMapTest, LastUserDropsEntriesOfItsGameStateOnly)
+{
+	SharedThreatMap::addUser(1);
+	SharedThreatMap::addUser(1);
+	SharedThreatMap::addUser(2);
+
+	SharedThreatMap::get(key(TeamID(0), 1, 1), calculator());
+	SharedThreatMap::get(key(TeamID(1), 1, 1), calculator());
+	SharedThreatMap::get(key(TeamID(0), 1, 2), calculator());
+
+	EXPECT_EQ(SharedThreatMap::size(), 3);
+
+	// other AI of the same game still uses the entries
+	SharedThreatMap::removeUser(1);
+	EXPECT_EQ(SharedThreatMap::size(), 3);
+
+	SharedThreatMap::removeUser(1);
+	EXPECT_EQ(SharedThreatMap::size(), 1);
+
+	SharedThreatMap::get(key(TeamID(0), 1, 2), calculator());
+	EXPECT_EQ(calculations, 3);
+
+	SharedThreatMap::removeUser(2);
+	EXPECT_EQ(SharedThreatMap::size(), 0);
+}
+
+}
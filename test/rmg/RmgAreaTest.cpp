@@ -0,0 +1,124 @@
+/*
+ * RmgAreaTest.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#include "StdInc.h"
+
+#include "../../lib/rmg/RmgArea.h"
+
+namespace test
+{
+using namespace ::rmg;
+using namespace ::testing;
+
+class RmgAreaTest : public TestWithParam<int>
+{
+protected:
+	/// random blob wide enough to span several bitmap words, on both levels
+	Tileset randomTiles() const
+	{
+		std::mt19937 rng(GetParam());
+		std::uniform_int_distribution<int> coord(0, 149);
+		std::uniform_int_distribution<int> radius(1, 12);
+		Tileset tiles;
+
+		for(int z = 0; z < 2; z++)
+		{
+			for(int blob = 0; blob < 12; blob++)
+			{
+				int3 center(coord(rng), coord(rng) / 3, z);
+				int r = radius(rng);
+
+				for(int x = center.x - r; x <= center.x + r; x++)
+				{
+					for(int y = center.y - r; y <= center.y + r; y++)
+					{
+						if((x - center.x) * (x - center.x) + (y - center.y) * (y - center.y) <= r * r)
+							tiles.insert(int3(x, y, z));
+					}
+				}
+			}
+
+			// single tiles and holes
+			for(int i = 0; i < 200; i++)
+			{
+				int3 tile(coord(rng), coord(rng) / 3, z);
+				if(i % 2)
+					tiles.insert(tile);
+				else
+					tiles.erase(tile);
+			}
+		}
+		return tiles;
+	}
+
+	/// previous implementation, peels getBorder() off the area until nothing remains
+	static DistanceMap peelBorders(const Area & source, std::map<int, Tileset> & reverseDistanceMap)
+	{
+		reverseDistanceMap.clear();
+		DistanceMap result;
+		auto area = source;
+		int distance = 0;
+
+		while(!area.empty())
+		{
+			for(const auto & tile : area.getBorder())
+				result[tile] = distance;
+			reverseDistanceMap[distance++] = area.getBorder();
+			area.subtract(area.getBorder());
+		}
+		return result;
+	}
+};
+
+TEST_P(RmgAreaTest, erodedRemovesBorder)
+{
+	Tileset tiles = randomTiles();
+	Area area(tiles);
+	TileBitmap bitmap(tiles);
+	TileBitmap inner = bitmap.eroded();
+
+	for(const auto & tile : tiles)
+		EXPECT_EQ(inner.contains(tile), !area.getBorder().count(tile)) << tile.toString();
+
+	for(const auto & tile : area.getBorderOutside())
+		EXPECT_FALSE(inner.contains(tile)) << tile.toString();
+}
+
+TEST_P(RmgAreaTest, distanceMapMatchesBorderPeeling)
+{
+	Area area(randomTiles());
+
+	std::map<int, Tileset> expectedReverse;
+	std::map<int, Tileset> actualReverse;
+	auto expected = peelBorders(area, expectedReverse);
+	auto actual = area.computeDistanceMap(actualReverse);
+
+	EXPECT_EQ(actual, expected);
+	ASSERT_EQ(actualReverse.size(), expectedReverse.size());
+
+	for(const auto & layer : expectedReverse)
+	{
+		const auto & actualLayer = actualReverse[layer.first];
+		EXPECT_EQ(actualLayer, layer.second) << "distance " << layer.first;
+		// generator picks tiles in iteration order, so it must not change either
+		EXPECT_TRUE(std::equal(actualLayer.begin(), actualLayer.end(), layer.second.begin(), layer.second.end())) << "distance " << layer.first;
+	}
+}
+
+TEST(RmgAreaBitmapTest, erodedSingleTileIsEmpty)
+{
+	TileBitmap bitmap(Tileset{int3(63, 0, 0)});
+
+	EXPECT_FALSE(bitmap.empty());
+	EXPECT_TRUE(bitmap.eroded().empty());
+}
+
+INSTANTIATE_TEST_SUITE_P(Seeds, RmgAreaTest, Values(1, 2, 3, 42, 1337));
+
+}
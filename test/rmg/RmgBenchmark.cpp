@@ -0,0 +1,157 @@
+/*
+ * RmgBenchmark.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#include "StdInc.h"
+
+#include "../../lib/VCMI_Lib.h"
+#include "../../lib/VCMIDirs.h"
+#include "../../lib/json/JsonNode.h"
+#include "../../lib/mapping/CMap.h"
+#include "../../lib/rmg/CMapGenOptions.h"
+#include "../../lib/rmg/CMapGenerator.h"
+#include "../../lib/rmg/CRmgTemplate.h"
+#include "../../lib/rmg/CRmgTemplateStorage.h"
+
+#ifdef VCMI_UNIX
+#include <sys/resource.h>
+#endif
+
+// Generates maps for a matrix of templates, sizes, seeds and player counts and writes timings as JSON.
+// Requires game data, run with --gtest_also_run_disabled_tests --gtest_filter=RmgBenchmark.*
+// VCMI_RMG_BENCHMARK_TEMPLATES limits run to comma-separated list of template ids,
+// VCMI_RMG_BENCHMARK_OUTPUT overrides path of resulting file (rmg_benchmark.json in user data dir by default).
+// processPeakRssKb is a running maximum of the whole process, so it only grows when a run needs more memory than all runs before it
+
+namespace test
+{
+
+static const std::vector<int> BENCHMARK_SIZES = { CMapHeader::MAP_SIZE_SMALL, CMapHeader::MAP_SIZE_MIDDLE, CMapHeader::MAP_SIZE_LARGE, CMapHeader::MAP_SIZE_XLARGE };
+static const std::vector<int> BENCHMARK_SEEDS = { 1337, 4242, 90210 };
+static const std::vector<int> BENCHMARK_PLAYERS = { 2, 4, 8 };
+static const int MAX_ATTEMPTS = 3;
+
+/// peak resident set of the process since start, not of a single run
+static si64 processPeakResidentSetKb()
+{
+#ifdef VCMI_UNIX
+	struct rusage usage;
+	getrusage(RUSAGE_SELF, &usage);
+#ifdef VCMI_APPLE
+	return usage.ru_maxrss / 1024; //reported in bytes
+#else
+	return usage.ru_maxrss;
+#endif
+#else
+	return 0;
+#endif
+}
+
+static std::vector<const CRmgTemplate *> selectTemplates()
+{
+	auto templates = VLC->tplh->getTemplates();
+
+	const char * filter = std::getenv("VCMI_RMG_BENCHMARK_TEMPLATES");
+	if(!filter)
+		return templates;
+
+	std::vector<std::string> names;
+	boost::split(names, filter, boost::is_any_of(","));
+	vstd::erase_if(templates, [&names](const CRmgTemplate * tmpl)
+	{
+		return !vstd::contains(names, tmpl->getId());
+	});
+	return templates;
+}
+
+static JsonNode generateMap(const CRmgTemplate * tmpl, int size, int players, int seed)
+{
+	JsonNode run;
+	run["template"].String() = tmpl->getId();
+	run["size"].Integer() = size;
+	run["players"].Integer() = players;
+	run["seed"].Integer() = seed;
+
+	for(int attempt = 0; attempt < MAX_ATTEMPTS; attempt++)
+	{
+		CMapGenOptions opt;
+		opt.setWidth(size);
+		opt.setHeight(size);
+		opt.setHasTwoLevels(false);
+		opt.setHumanOrCpuPlayerCount(players);
+		opt.setMapTemplate(tmpl);
+
+		auto start = std::chrono::steady_clock::now();
+		try
+		{
+			CMapGenerator gen(opt, nullptr, seed + attempt);
+			auto map = gen.generate();
+
+			run["wallTimeMs"].Integer() = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+			run["retries"].Integer() = attempt;
+			run["failed"].Bool() = false;
+
+			int modificatorFailures = 0;
+			for(const auto & stage : gen.getModificatorTimes())
+			{
+				auto & entry = run["modificators"][stage.first];
+				entry["totalMs"].Integer() = stage.second.total.count();
+				entry["slowestZoneMs"].Integer() = stage.second.longest.count();
+				entry["zones"].Integer() = stage.second.zones;
+				entry["failures"].Integer() = stage.second.failures;
+				modificatorFailures += stage.second.failures;
+			}
+			run["modificatorFailures"].Integer() = modificatorFailures;
+			run["processPeakRssKb"].Integer() = processPeakResidentSetKb();
+			return run;
+		}
+		catch(const std::exception & e)
+		{
+			logGlobal->warn("RMG benchmark: %s %dx%d, %d players, seed %d failed: %s", tmpl->getId(), size, size, players, seed + attempt, e.what());
+		}
+	}
+
+	run["retries"].Integer() = MAX_ATTEMPTS - 1;
+	run["failed"].Bool() = true;
+	run["processPeakRssKb"].Integer() = processPeakResidentSetKb();
+	return run;
+}
+
+TEST(RmgBenchmark, DISABLED_GenerationMatrix)
+{
+	JsonNode result;
+
+	for(const auto * tmpl : selectTemplates())
+	{
+		for(int size : BENCHMARK_SIZES)
+		{
+			int3 dimensions(size, size, 1);
+			if(!tmpl->matchesSize(dimensions))
+				continue;
+
+			for(int players : BENCHMARK_PLAYERS)
+			{
+				if(!tmpl->getPlayers().isInRange(players))
+					continue;
+
+				for(int seed : BENCHMARK_SEEDS)
+					result["runs"].Vector().push_back(generateMap(tmpl, size, players, seed));
+			}
+		}
+	}
+
+	const char * output = std::getenv("VCMI_RMG_BENCHMARK_OUTPUT");
+	auto path = output ? boost::filesystem::path(output) : VCMIDirs::get().userDataPath() / "rmg_benchmark.json";
+	std::ofstream file(path.c_str());
+	file << result.toString();
+
+	EXPECT_TRUE(file.good());
+	logGlobal->info("RMG benchmark: %d runs written to %s", result["runs"].Vector().size(), path.string());
+}
+
+}
@@ -0,0 +1,221 @@
+/*
+ * RmgPathTest.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#include "StdInc.h"
+
+#include "../../lib/rmg/RmgPath.h"
+
+namespace test
+{
+using namespace ::rmg;
+using namespace ::testing;
+
+class RmgPathTest : public Test
+{
+public:
+	static const int SIZE = 20;
+
+protected:
+	Area area;
+
+	void fillArea()
+	{
+		Tileset tiles;
+		for(int x = 0; x < SIZE; x++)
+			for(int y = 0; y < SIZE; y++)
+				tiles.insert(int3(x, y, 0));
+		area = Area(tiles);
+	}
+
+	/// vertical wall at given x, with optional gap at given y
+	void addWall(int x, int gapY = -1)
+	{
+		for(int y = 0; y < SIZE; y++)
+		{
+			if(y != gapY)
+				area.erase(int3(x, y, 0));
+		}
+	}
+
+	/// number of straight steps of shortest path within area, -1 if there is none
+	int shortestDistance(const int3 & src, const int3 & dst) const
+	{
+		std::map<int3, int> distance;
+		std::deque<int3> queue;
+
+		distance[src] = 0;
+		queue.push_back(src);
+
+		while(!queue.empty())
+		{
+			int3 tile = queue.front();
+			queue.pop_front();
+
+			if(tile == dst)
+				return distance[tile];
+
+			for(const auto & dir : dirs4)
+			{
+				int3 next = tile + dir;
+				if((area.contains(next) || next == dst) && !distance.count(next))
+				{
+					distance[next] = distance[tile] + 1;
+					queue.push_back(next);
+				}
+			}
+		}
+		return -1;
+	}
+};
+
+TEST_F(RmgPathTest, straightPathHasShortestLength)
+{
+	fillArea();
+
+	Path origin(area, int3(2, 3, 0));
+	Path result = origin.search(int3(15, 11, 0), true);
+
+	ASSERT_TRUE(result.valid());
+	// both ends are included
+	EXPECT_EQ(result.getPathArea().getTiles().size(), 13 + 8 + 1);
+}
+
+TEST_F(RmgPathTest, diagonalPathHasShortestLength)
+{
+	fillArea();
+
+	Path origin(area, int3(2, 3, 0));
+	Path result = origin.search(int3(15, 11, 0), false);
+
+	ASSERT_TRUE(result.valid());
+	EXPECT_EQ(result.getPathArea().getTiles().size(), 13 + 1);
+}
+
+TEST_F(RmgPathTest, pathAroundObstaclesIsOptimal)
+{
+	fillArea();
+	addWall(5, 17);
+	addWall(10, 2);
+	addWall(15, 12);
+
+	const int3 src(1, 1, 0);
+	const int3 dst(18, 1, 0);
+
+	Path origin(area, src);
+	Path result = origin.search(dst, true);
+
+	ASSERT_TRUE(result.valid());
+	EXPECT_EQ(result.getPathArea().getTiles().size(), shortestDistance(src, dst) + 1);
+
+	for(const auto & tile : result.getPathArea().getTiles())
+		EXPECT_TRUE(area.contains(tile) || tile == dst);
+}
+
+TEST_F(RmgPathTest, moveCostIsAvoided)
+{
+	fillArea();
+
+	Path origin(area, int3(0, 10, 0));
+	// crossing row 10 directly is expensive, so detour through row 9 is cheaper
+	auto cost = [](const int3 & src, const int3 & dst) -> float
+	{
+		return dst.y == 10 && dst.x > 0 && dst.x < 10 ? 100.f : 0.f;
+	};
+	Path result = origin.search(int3(10, 10, 0), true, cost);
+
+	ASSERT_TRUE(result.valid());
+	EXPECT_TRUE(result.getPathArea().contains(int3(5, 9, 0)) || result.getPathArea().contains(int3(5, 11, 0)));
+	EXPECT_FALSE(result.getPathArea().contains(int3(5, 10, 0)));
+}
+
+TEST_F(RmgPathTest, unreachableTargetGivesInvalidPath)
+{
+	fillArea();
+	addWall(10);
+
+	Path origin(area, int3(2, 2, 0));
+
+	EXPECT_FALSE(origin.search(int3(15, 15, 0), true).valid());
+	EXPECT_FALSE(origin.search(int3(15, 15, 0), false).valid());
+}
+
+TEST_F(RmgPathTest, searchAllMatchesSeparateSearches)
+{
+	fillArea();
+	addWall(8, 4);
+	addWall(14, 16);
+
+	Path origin(area, int3(1, 10, 0));
+	origin.connect(int3(2, 10, 0));
+
+	std::vector<Tileset> targets = {
+		{ int3(18, 18, 0) },
+		{ int3(5, 1, 0), int3(6, 1, 0) },
+		{ int3(11, 10, 0) },
+	};
+
+	auto results = origin.searchAll(targets, true);
+
+	ASSERT_EQ(results.size(), targets.size());
+
+	for(size_t i = 0; i < targets.size(); i++)
+	{
+		auto single = origin.search(targets[i], true);
+
+		ASSERT_TRUE(results[i].valid());
+		EXPECT_EQ(results[i].getPathArea().getTiles().size(), single.getPathArea().getTiles().size());
+		EXPECT_TRUE(results[i].getPathArea().overlap(origin.getPathArea()));
+		EXPECT_TRUE(results[i].getPathArea().overlap(Area(targets[i])));
+	}
+}
+
+TEST_F(RmgPathTest, searchAllSkipsUnreachableTargets)
+{
+	fillArea();
+	addWall(10);
+
+	Path origin(area, int3(2, 2, 0));
+
+	std::vector<Tileset> targets = {
+		{ int3(15, 15, 0) },
+		{ int3(7, 7, 0) },
+		{},
+	};
+
+	auto results = origin.searchAll(targets, false);
+
+	ASSERT_EQ(results.size(), targets.size());
+	EXPECT_FALSE(results[0].valid());
+	ASSERT_TRUE(results[1].valid());
+	EXPECT_EQ(results[1].getPathArea().getTiles().size(), 5 + 1);
+	EXPECT_FALSE(results[2].valid());
+}
+
+TEST_F(RmgPathTest, targetOutsideMapIsNotReached)
+{
+	fillArea();
+
+	Path origin(area, int3(5, 5, 0));
+
+	EXPECT_FALSE(origin.search(int3(-1, 5, 0), true).valid());
+
+	std::vector<Tileset> targets = {
+		{ int3(-1, 5, 0) },
+		{ int3(-1, 7, 0), int3(0, 7, 0) },
+	};
+
+	auto results = origin.searchAll(targets, true);
+
+	ASSERT_EQ(results.size(), targets.size());
+	EXPECT_FALSE(results[0].valid());
+	ASSERT_TRUE(results[1].valid());
+	EXPECT_FALSE(results[1].getPathArea().contains(int3(-1, 7, 0)));
+}
+
+}
@@ -0,0 +1,43 @@
+/*
+ * AllocationCounter.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#include "StdInc.h"
+#include "AllocationCounter.h"
+
+// Replacement operators are kept apart from code that allocates. If GCC inlines them into a caller,
+// it reports free() of memory returned by operator new as -Wmismatched-new-delete
+static std::atomic<uint64_t> allocations = 0;
+
+void * operator new(std::size_t size)
+{
+	allocations.fetch_add(1, std::memory_order_relaxed);
+	if(void * ptr = std::malloc(size ? size : 1))
+		return ptr;
+	throw std::bad_alloc();
+}
+
+void operator delete(void * ptr) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete(void * ptr, std::size_t) noexcept
+{
+	std::free(ptr);
+}
+
+namespace test
+{
+
+uint64_t allocationsCount()
+{
+	return allocations.load(std::memory_order_relaxed);
+}
+
+}
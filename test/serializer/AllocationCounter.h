@@ -0,0 +1,19 @@
+/*
+ * AllocationCounter.h, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#pragma once
+
+namespace test
+{
+
+/// Number of calls to global operator new since start of executable.
+/// Only available in executables that link AllocationCounter.cpp
+uint64_t allocationsCount();
+
+}
@@ -0,0 +1,126 @@
+/*
+ * CSaveFileTest.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#include "StdInc.h"
+
+#include "../../lib/serializer/CSaveFile.h"
+#include "../../lib/serializer/CLoadFile.h"
+
+namespace test
+{
+
+using namespace ::testing;
+
+class CSaveFileTest : public Test
+{
+public:
+	boost::filesystem::path fileName;
+
+	CSaveFileTest()
+		: fileName(boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("vcmi-save-%%%%-%%%%.vsgm1"))
+	{
+	}
+
+	~CSaveFileTest()
+	{
+		boost::system::error_code ec;
+		boost::filesystem::remove(fileName, ec);
+	}
+};
+
+class CSaveFileRoundTripTest : public CSaveFileTest, public WithParamInterface<bool>
+{
+};
+
+TEST_P(CSaveFileRoundTripTest, SaveLoadRoundTrip)
+{
+	// large enough to span several compressed chunks
+	std::vector<si32> numbers(1000000);
+	for(size_t i = 0; i < numbers.size(); ++i)
+		numbers[i] = static_cast<si32>(i * 7919 % 10007);
+	std::string text = "Round trip";
+
+	{
+		CSaveFile save(fileName, GetParam());
+		save.putMagicBytes("TEST");
+		save << numbers << text;
+	}
+
+	std::vector<si32> loadedNumbers;
+	std::string loadedText;
+
+	CLoadFile load(fileName, ESerializationVersion::CURRENT);
+	load.checkMagicBytes("TEST");
+	load >> loadedNumbers >> loadedText;
+
+	EXPECT_EQ(loadedNumbers, numbers);
+	EXPECT_EQ(loadedText, text);
+}
+
+TEST_P(CSaveFileRoundTripTest, SnapshotLoadRoundTrip)
+{
+	std::vector<si32> numbers(1000000);
+	for(size_t i = 0; i < numbers.size(); ++i)
+		numbers[i] = static_cast<si32>(i * 7919 % 10007);
+	std::string text = "Snapshot";
+
+	CSaveSnapshot snapshot;
+	snapshot.putMagicBytes("TEST");
+	snapshot << numbers << text;
+	snapshot.writeToFile(fileName, GetParam());
+
+	std::vector<si32> loadedNumbers;
+	std::string loadedText;
+
+	CLoadFile load(fileName, ESerializationVersion::CURRENT);
+	load.checkMagicBytes("TEST");
+	load >> loadedNumbers >> loadedText;
+
+	EXPECT_EQ(loadedNumbers, numbers);
+	EXPECT_EQ(loadedText, text);
+}
+
+TEST_F(CSaveFileTest, CompressedSaveIsSmaller)
+{
+	std::vector<si32> zeroes(100000);
+
+	{
+		CSaveFile save(fileName, false);
+		save << zeroes;
+	}
+	auto plainSize = boost::filesystem::file_size(fileName);
+
+	{
+		CSaveFile save(fileName, true);
+		save << zeroes;
+	}
+	auto compressedSize = boost::filesystem::file_size(fileName);
+
+	EXPECT_LT(compressedSize, plainSize / 10);
+}
+
+TEST_F(CSaveFileTest, OversizedChunkIsRejected)
+{
+	CSaveFile(fileName, true).clear();
+
+	// chunk header claiming 4 GB of compressed data
+	{
+		std::ofstream file(fileName.c_str(), std::ios::binary | std::ios::app);
+		const std::array<ui32, 2> header = { 16, std::numeric_limits<ui32>::max() };
+		file.write(reinterpret_cast<const char *>(header.data()), sizeof(header));
+	}
+
+	CLoadFile load(fileName, ESerializationVersion::CURRENT);
+	si32 value = 0;
+	EXPECT_ANY_THROW(load >> value);
+}
+
+INSTANTIATE_TEST_SUITE_P(Compression, CSaveFileRoundTripTest, Values(false, true));
+
+}
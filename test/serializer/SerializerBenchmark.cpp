@@ -0,0 +1,376 @@
+/*
+ * SerializerBenchmark.cpp, part of VCMI engine
+ *
+ * Authors: listed in file AUTHORS in main folder
+ *
+ * License: GNU General Public License v2.0 or later
+ * Full text of license available in license.txt file, in main folder
+ *
+ */
+#include "StdInc.h"
+#include "AllocationCounter.h"
+
+#include "../../lib/CPlayerState.h"
+#include "../../lib/GameSettings.h"
+#include "../../lib/IGameCallback.h"
+#include "../../lib/RiverHandler.h"
+#include "../../lib/RoadHandler.h"
+#include "../../lib/StartInfo.h"
+#include "../../lib/TerrainHandler.h"
+#include "../../lib/VCMIDirs.h"
+#include "../../lib/bonuses/Limiters.h"
+#include "../../lib/bonuses/Propagators.h"
+#include "../../lib/bonuses/Updaters.h"
+#include "../../lib/campaign/CampaignState.h"
+#include "../../lib/entities/building/CBuilding.h"
+#include "../../lib/entities/hero/CHero.h"
+#include "../../lib/filesystem/ResourcePath.h"
+#include "../../lib/gameState/CGameState.h"
+#include "../../lib/gameState/CGameStateCampaign.h"
+#include "../../lib/gameState/QuestInfo.h"
+#include "../../lib/gameState/TavernHeroesPool.h"
+#include "../../lib/mapObjects/CGMarket.h"
+#include "../../lib/mapObjects/CGTownInstance.h"
+#include "../../lib/mapObjects/CQuest.h"
+#include "../../lib/mapObjects/MiscObjects.h"
+#include "../../lib/mapObjects/ObjectTemplate.h"
+#include "../../lib/mapObjects/TownBuildingInstance.h"
+#include "../../lib/mapping/CMap.h"
+#include "../../lib/mapping/CMapService.h"
+#include "../../lib/rmg/CMapGenOptions.h"
+#include "../../lib/rmg/CMapGenerator.h"
+#include "../../lib/serializer/BinaryDeserializer.h"
+#include "../../lib/serializer/BinarySerializer.h"
+#include "../../lib/serializer/CLoadFile.h"
+#include "../../lib/serializer/CMemorySerializer.h"
+#include "../../lib/serializer/CSaveFile.h"
+
+// Built as separate vcmiserializerbenchmark executable because of global operator new in AllocationCounter.cpp.
+// Benchmarks require a lot of time, run with --gtest_also_run_disabled_tests --gtest_filter=SerializerBenchmark.*
+// Maps and saves benchmarks also require game data.
+// VCMI_SERIALIZER_BENCHMARK_MAPS replaces generated maps with comma-separated list of map resources,
+// VCMI_SERIALIZER_BENCHMARK_SAVES replaces saves from user save dir with comma-separated list of files
+
+namespace test
+{
+
+using namespace ::testing;
+
+static const std::vector<int> BENCHMARK_SIZES = { CMapHeader::MAP_SIZE_SMALL, CMapHeader::MAP_SIZE_MIDDLE, CMapHeader::MAP_SIZE_LARGE, CMapHeader::MAP_SIZE_XLARGE };
+static const int BENCHMARK_SEED = 1337;
+
+/// Measures wall time and allocations between construction and stop
+class BenchmarkTimer
+{
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	uint64_t startAllocations = allocationsCount();
+	double seconds = 0;
+	uint64_t allocations = 0;
+
+public:
+	void stop()
+	{
+		seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		allocations = allocationsCount() - startAllocations;
+	}
+
+	void report(const std::string & step, size_t bytes, size_t objects) const
+	{
+		double megabytes = bytes / (1024.0 * 1024.0);
+		logGlobal->info("\t%s: %.3f s, %.1f MB/s, %.0f objects/s, %d allocations", step, seconds, megabytes / seconds, objects / seconds, allocations);
+	}
+
+	void report(const std::string & step) const
+	{
+		logGlobal->info("\t%s: %.3f s, %d allocations", step, seconds, allocations);
+	}
+};
+
+class BenchmarkPayload : public Serializeable
+{
+public:
+	std::string name;
+	si32 value = 0;
+
+	template <typename Handler> void serialize(Handler & h)
+	{
+		h & name;
+		h & value;
+	}
+};
+
+class BenchmarkNode : public Serializeable
+{
+public:
+	si32 value = 0;
+	BenchmarkNode * next = nullptr;
+	std::shared_ptr<BenchmarkPayload> payload;
+
+	template <typename Handler> void serialize(Handler & h)
+	{
+		h & value;
+		h & next;
+		h & payload;
+	}
+};
+
+/// Object graph where every node is referenced several times, like objects of game state
+class BenchmarkGraph
+{
+public:
+	std::vector<BenchmarkNode *> nodes;
+
+	BenchmarkGraph() = default;
+
+	BenchmarkGraph(size_t size)
+	{
+		std::vector<std::shared_ptr<BenchmarkPayload>> payloads(size / 4 + 1);
+		for(size_t i = 0; i < payloads.size(); ++i)
+		{
+			payloads[i] = std::make_shared<BenchmarkPayload>();
+			payloads[i]->name = "payload" + std::to_string(i % 100);
+			payloads[i]->value = static_cast<si32>(i);
+		}
+
+		for(size_t i = 0; i < size; ++i)
+		{
+			nodes.push_back(new BenchmarkNode());
+			nodes.back()->value = static_cast<si32>(i);
+			nodes.back()->payload = payloads[i * 7 % payloads.size()];
+		}
+
+		// only earlier nodes are referenced, so saving does not recurse deeply
+		for(size_t i = 0; i < size; ++i)
+			nodes[i]->next = nodes[i * 7919 % (i + 1)];
+	}
+
+	~BenchmarkGraph()
+	{
+		for(auto * node : nodes)
+			delete node;
+	}
+
+	template <typename Handler> void serialize(Handler & h)
+	{
+		h & nodes;
+	}
+};
+
+class BenchmarkBuffer : public IBinaryReader, public IBinaryWriter
+{
+public:
+	std::vector<std::byte> buffer;
+	size_t readPos = 0;
+
+	int read(std::byte * data, unsigned size) override
+	{
+		if(readPos + size > buffer.size())
+			throw std::runtime_error("Read past end of benchmark buffer!");
+
+		std::copy_n(buffer.data() + readPos, size, data);
+		readPos += size;
+		return size;
+	}
+
+	int write(const std::byte * data, unsigned size) override
+	{
+		buffer.insert(buffer.end(), data, data + size);
+		return size;
+	}
+};
+
+static void roundTrip(const BenchmarkGraph & source, BenchmarkGraph & target, BenchmarkBuffer & buffer)
+{
+	BinarySerializer saver(&buffer);
+	saver & source;
+
+	BinaryDeserializer loader(&buffer);
+	loader.version = ESerializationVersion::CURRENT;
+	loader & target;
+}
+
+TEST(SerializerPointerTables, RoundTripKeepsSharedObjects)
+{
+	BenchmarkGraph source(1000);
+	BenchmarkGraph target;
+	BenchmarkBuffer buffer;
+
+	roundTrip(source, target, buffer);
+
+	ASSERT_EQ(target.nodes.size(), source.nodes.size());
+	for(size_t i = 0; i < source.nodes.size(); ++i)
+	{
+		EXPECT_EQ(target.nodes[i]->value, source.nodes[i]->value);
+		EXPECT_EQ(target.nodes[i]->next, target.nodes[i * 7919 % (i + 1)]);
+		EXPECT_EQ(target.nodes[i]->payload->name, source.nodes[i]->payload->name);
+	}
+	// payload shared by two nodes in source is still shared after loading
+	EXPECT_EQ(target.nodes[0]->payload, target.nodes[source.nodes.size() / 4 + 1]->payload);
+}
+
+TEST(SerializerBenchmark, DISABLED_PointerTables)
+{
+	static const size_t nodesCount = 1000000;
+
+	BenchmarkGraph source(nodesCount);
+	BenchmarkGraph target;
+	BenchmarkBuffer buffer;
+
+	logGlobal->info("Serializer benchmark: %d objects", nodesCount);
+
+	BenchmarkTimer saveTimer;
+	BinarySerializer saver(&buffer);
+	saver & source;
+	saveTimer.stop();
+	saveTimer.report("save", buffer.buffer.size(), saver.savedPointers.size());
+
+	BenchmarkTimer loadTimer;
+	BinaryDeserializer loader(&buffer);
+	loader.version = ESerializationVersion::CURRENT;
+	loader & target;
+	loadTimer.stop();
+	loadTimer.report("load", buffer.buffer.size(), loader.loadedPointers.size());
+
+	ASSERT_EQ(target.nodes.size(), nodesCount);
+}
+
+static std::vector<std::string> benchmarkInputs(const char * variable)
+{
+	std::vector<std::string> result;
+	const char * list = std::getenv(variable);
+	if(list)
+		boost::split(result, list, boost::is_any_of(","));
+	return result;
+}
+
+static std::vector<std::unique_ptr<CMap>> loadBenchmarkMaps()
+{
+	std::vector<std::unique_ptr<CMap>> maps;
+	auto names = benchmarkInputs("VCMI_SERIALIZER_BENCHMARK_MAPS");
+
+	if(!names.empty())
+	{
+		CMapService mapService;
+		for(const auto & name : names)
+			maps.push_back(mapService.loadMap(ResourcePath(name, EResType::MAP), nullptr));
+		return maps;
+	}
+
+	for(int size : BENCHMARK_SIZES)
+	{
+		CMapGenOptions opt;
+		opt.setWidth(size);
+		opt.setHeight(size);
+		opt.setHasTwoLevels(true);
+		opt.setHumanOrCpuPlayerCount(4);
+
+		CMapGenerator gen(opt, nullptr, BENCHMARK_SEED);
+		maps.push_back(gen.generate());
+	}
+	return maps;
+}
+
+static std::vector<boost::filesystem::path> selectBenchmarkSaves()
+{
+	std::vector<boost::filesystem::path> saves;
+	for(const auto & name : benchmarkInputs("VCMI_SERIALIZER_BENCHMARK_SAVES"))
+		saves.emplace_back(name);
+
+	if(!saves.empty() || !boost::filesystem::is_directory(VCMIDirs::get().userSavePath()))
+		return saves;
+
+	for(const auto & entry : boost::filesystem::recursive_directory_iterator(VCMIDirs::get().userSavePath()))
+	{
+		if(boost::algorithm::iequals(entry.path().extension().string(), ".vsgm1"))
+			saves.push_back(entry.path());
+	}
+	return saves;
+}
+
+/// Reads and writes game state the same way as server does for saved games
+class BenchmarkSaveAccess : public CPrivilegedInfoCallback
+{
+public:
+	std::unique_ptr<CGameState> state;
+
+	void load(CLoadFile & in)
+	{
+		loadCommonState(in);
+		state.reset(gs);
+	}
+
+	void save(CSaveSnapshot & out) const
+	{
+		saveCommonState(out);
+	}
+};
+
+TEST(SerializerBenchmark, DISABLED_Maps)
+{
+	for(const auto & map : loadBenchmarkMaps())
+	{
+		logGlobal->info("Serializer benchmark: %dx%dx%d map, %d objects", map->width, map->height, map->levels(), map->objects.size());
+
+		BenchmarkBuffer buffer;
+		const CMap * source = map.get();
+
+		BenchmarkTimer saveTimer;
+		BinarySerializer saver(&buffer);
+		saver & source;
+		saveTimer.stop();
+		saveTimer.report("save", buffer.buffer.size(), saver.savedPointers.size());
+
+		std::unique_ptr<CMap> loaded;
+		BenchmarkTimer loadTimer;
+		BinaryDeserializer loader(&buffer);
+		loader.version = ESerializationVersion::CURRENT;
+		loader & loaded;
+		loadTimer.stop();
+		loadTimer.report("load", buffer.buffer.size(), loader.loadedPointers.size());
+
+		ASSERT_NE(loaded, nullptr);
+		EXPECT_EQ(loaded->objects.size(), map->objects.size());
+	}
+}
+
+TEST(SerializerBenchmark, DISABLED_Saves)
+{
+	auto saves = selectBenchmarkSaves();
+	if(saves.empty())
+		GTEST_SKIP() << "No saved games found";
+
+	for(const auto & path : saves)
+	{
+		logGlobal->info("Serializer benchmark: %s", path.string());
+		BenchmarkSaveAccess access;
+
+		BenchmarkTimer loadTimer;
+		CLoadFile in(path, ESerializationVersion::MINIMAL);
+		access.load(in);
+		loadTimer.stop();
+		ASSERT_NE(access.state, nullptr);
+
+		BenchmarkTimer saveTimer;
+		CSaveSnapshot snapshot;
+		access.save(snapshot);
+		saveTimer.stop();
+
+		// load throughput is reported in uncompressed bytes, same as for saving
+		loadTimer.report("load", snapshot.size(), in.serializer.loadedPointers.size());
+		saveTimer.report("save", snapshot.size(), snapshot.serializer.savedPointers.size());
+
+		BenchmarkTimer startInfoTimer;
+		auto startInfo = CMemorySerializer::deepCopy(*access.state->scenarioOps);
+		startInfoTimer.stop();
+		startInfoTimer.report("deepCopy StartInfo");
+
+		BenchmarkTimer gameStateTimer;
+		auto gameState = CMemorySerializer::deepCopy(*access.state);
+		gameStateTimer.stop();
+		gameStateTimer.report("deepCopy CGameState");
+
+		EXPECT_EQ(gameState->day, access.state->day);
+	}
+}
+
+}